@@ -0,0 +1,276 @@
+/*******************************************************************************
+**
+**  Title:   UTF-16 transcoding micro-benchmark
+**  File:  	 utf16-transcode.c
+**
+**  Purpose: Compares the per char RL_SET_CHAR/RL_GET_CHAR loops formerly used
+**           to convert between ODBC's UTF-16 and REBOL strings with the bulk
+**           kernels of host-odbc-text.h. The host's series functions are
+**           modelled after R3's RL_Set_Char/RL_Get_Char (out of line calls,
+**           tail check and expansion per char).
+**
+**           Decoding mirrors ODBC_SqlWCharsToString. R3's RL_MAKE_STRING
+**           returns series with a tail of 0, so with the stock host decoding
+**           still fills in the series per char with RL_SET_CHAR, the gain is
+**           only from the length indicator and byte-wide series for Latin-1
+**           text. The one pass fill only runs with a host returning series
+**           sized to the length asked for, shown as "sized host".
+**
+**  Build:   cc -O2 -I../src/os/win32 utf16-transcode.c -o utf16-transcode
+**           cl /O2 /I..\src\os\win32 utf16-transcode.c
+**
+**  Results: x86-64, gcc 12 -O2 (SSE2), 64 char column values, Mchars/s,
+**           medians of 5 runs on a shared machine (runs vary by about 20%)
+**
+**                                  before     after  sized host
+**           decode ASCII              150       180        1500   (byte-wide series)
+**           decode Latin-1            155       170        1370   (byte-wide series)
+**           decode Cyrillic           150       185        1500   (wide series)
+**           encode ASCII              390      8800
+**
+*******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "host-odbc-text.h"
+
+#define VALUE_LENGTH 64
+#define NUM_VALUES   4096
+#define ROUNDS       200
+
+#if defined(_MSC_VER)
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+typedef struct {
+	void   *data;
+	size_t  tail, size;
+	int     wide;
+} SERIES;
+
+
+/*------------------------------------------------------------------------------
+**
+**  Host model
+**
+/*----------------------------------------------------------------------------*/
+
+static SERIES *Make_String(size_t size, int unicode, int sized)
+{
+	SERIES *series = malloc(sizeof(SERIES));
+
+	series->wide = unicode ? 2 : 1;
+	series->size = size + 1;
+	series->tail = sized ? size : 0;
+	series->data = malloc(series->size * series->wide);
+
+	return series;
+}
+
+static void Free_String(SERIES *series)
+{
+	free(series->data);
+	free(series);
+}
+
+static NOINLINE void Expand_Tail(SERIES *series)
+{
+	if (series->tail + 1 >= series->size)
+	{
+		series->size = series->size * 2 + 1;
+		series->data = realloc(series->data, series->size * series->wide);
+	}
+	series->tail++;
+}
+
+static NOINLINE unsigned Set_Char(SERIES *series, size_t index, unsigned chr)
+{
+	if (index >= series->tail) { index = series->tail; Expand_Tail(series); }
+
+	if (series->wide == 1) ((unsigned char  *)series->data)[index] = (unsigned char)chr;
+	else                   ((unsigned short *)series->data)[index] = (unsigned short)chr;
+
+	return (unsigned)index;
+}
+
+static NOINLINE unsigned Get_Char(SERIES *series, size_t index)
+{
+	return series->wide == 1 ? ((unsigned char *)series->data)[index] : ((unsigned short *)series->data)[index];
+}
+
+static size_t Utf16_Strlen(const unsigned short *source)
+{
+	size_t i = 0;
+	while (source[i]) i++;
+	return i;
+}
+
+
+/*------------------------------------------------------------------------------
+**
+**  Before: lstrlenW, then RL_SET_CHAR per char into a wide series
+**
+/*----------------------------------------------------------------------------*/
+
+static SERIES *Decode_Before(const unsigned short *source)
+{
+	size_t  i, length = Utf16_Strlen(source);
+	SERIES *target    = Make_String(length, 1, 0);
+
+	for (i = 0; i < length; i++) Set_Char(target, i, source[i]);
+
+	return target;
+}
+
+static size_t Encode_Before(SERIES *source, unsigned short *target)
+{
+	size_t i;
+
+	for (i = 0; i < source->tail; i++) target[i] = (unsigned short)Get_Char(source, i);
+
+	return i;
+}
+
+
+/*------------------------------------------------------------------------------
+**
+**  After: length indicator, Latin-1 check, one pass fill if the host returned
+**  a sized series (SIZED), else RL_SET_CHAR per char as ODBC_SqlWCharsToString
+**
+/*----------------------------------------------------------------------------*/
+
+static SERIES *Decode_After(const unsigned short *source, size_t length, int sized)
+{
+	int     latin1 = Text_Utf16IsLatin1(source, length);
+	SERIES *target = Make_String(length, !latin1, sized);
+	size_t  i;
+
+	if (target->tail == length)
+	{
+		if (latin1) Text_Utf16ToLatin1(target->data, source, length);
+		else        memcpy(target->data, source, length * sizeof(unsigned short));
+
+		return target;
+	}
+
+	for (i = 0; i < length; i++) Set_Char(target, i, source[i]);
+
+	return target;
+}
+
+static size_t Encode_After(SERIES *source, unsigned short *target)
+{
+	if (source->wide == 1) Text_Latin1ToUtf16(target, source->data, source->tail);
+	else                   memcpy(target, source->data, source->tail * sizeof(unsigned short));
+
+	return source->tail;
+}
+
+
+/*------------------------------------------------------------------------------
+**
+/*----------------------------------------------------------------------------*/
+
+static double Seconds(void)
+{
+	return (double)clock() / CLOCKS_PER_SEC;
+}
+
+static void Fill(unsigned short *values, unsigned short first, unsigned short range)
+{
+	size_t v, i;
+
+	for (v = 0; v < NUM_VALUES; v++)
+	{
+		for (i = 0; i < VALUE_LENGTH; i++) values[v * (VALUE_LENGTH + 1) + i] = first + (unsigned short)((v + i) % range);
+		values[v * (VALUE_LENGTH + 1) + VALUE_LENGTH] = 0;
+	}
+}
+
+static void Bench_Decode(const char *name, unsigned short first, unsigned short range)
+{
+	unsigned short *values = malloc(sizeof(unsigned short) * NUM_VALUES * (VALUE_LENGTH + 1));
+	double          start, before, after, sized;
+	size_t          r, v, check = 0;
+
+	Fill(values, first, range);
+
+	start = Seconds();
+	for (r = 0; r < ROUNDS; r++) for (v = 0; v < NUM_VALUES; v++)
+	{
+		SERIES *s = Decode_Before(values + v * (VALUE_LENGTH + 1));
+		check += s->tail;
+		Free_String(s);
+	}
+	before = Seconds() - start;
+
+	start = Seconds();
+	for (r = 0; r < ROUNDS; r++) for (v = 0; v < NUM_VALUES; v++)
+	{
+		SERIES *s = Decode_After(values + v * (VALUE_LENGTH + 1), VALUE_LENGTH, 0);
+		check += s->tail;
+		Free_String(s);
+	}
+	after = Seconds() - start;
+
+	start = Seconds();
+	for (r = 0; r < ROUNDS; r++) for (v = 0; v < NUM_VALUES; v++)
+	{
+		SERIES *s = Decode_After(values + v * (VALUE_LENGTH + 1), VALUE_LENGTH, 1);
+		check += s->tail;
+		Free_String(s);
+	}
+	sized = Seconds() - start;
+
+	printf("decode %-10s %10.0f %10.0f %10.0f Mchars/s  (%lu)\n", name,
+		ROUNDS * NUM_VALUES * VALUE_LENGTH / before / 1e6,
+		ROUNDS * NUM_VALUES * VALUE_LENGTH / after  / 1e6,
+		ROUNDS * NUM_VALUES * VALUE_LENGTH / sized  / 1e6,
+		(unsigned long)check
+	);
+
+	free(values);
+}
+
+static void Bench_Encode(void)
+{
+	unsigned short  target[VALUE_LENGTH + 1];
+	SERIES         *source = Make_String(VALUE_LENGTH, 0, 1);
+	double          start, before, after;
+	size_t          r, v, check = 0;
+
+	memset(source->data, 'x', VALUE_LENGTH);
+
+	start = Seconds();
+	for (r = 0; r < ROUNDS; r++) for (v = 0; v < NUM_VALUES; v++) check += Encode_Before(source, target) + target[v % VALUE_LENGTH];
+	before = Seconds() - start;
+
+	start = Seconds();
+	for (r = 0; r < ROUNDS; r++) for (v = 0; v < NUM_VALUES; v++) check += Encode_After(source, target) + target[v % VALUE_LENGTH];
+	after = Seconds() - start;
+
+	printf("encode %-10s %10.0f %10.0f Mchars/s  (%lu)\n", "ASCII",
+		ROUNDS * NUM_VALUES * VALUE_LENGTH / before / 1e6,
+		ROUNDS * NUM_VALUES * VALUE_LENGTH / after  / 1e6,
+		(unsigned long)check
+	);
+
+	Free_String(source);
+}
+
+int main(void)
+{
+	printf("                      before      after sized host\n");
+
+	Bench_Decode("ASCII",    0x20,  0x5F);
+	Bench_Decode("Latin-1",  0xA0,  0x60);
+	Bench_Decode("Cyrillic", 0x410, 0x40);
+	Bench_Encode();
+
+	return 0;
+}
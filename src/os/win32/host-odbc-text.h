@@ -0,0 +1,130 @@
+/*******************************************************************************
+**
+**  Title:   ODBC Interface, UTF-16 transcoding kernels
+**  File:  	 host-odbc-text.h
+**
+**  Purpose: Bulk conversion between the UTF-16 text of ODBC and the byte-wide
+**           (Latin-1) or word-wide (UCS-2) string series of REBOL3.
+**
+**           Kept free of REBOL and ODBC dependencies, so the kernels can be
+**           benchmarked standalone, see bench/utf16-transcode.c.
+**
+**  Author:  Christian Ensel
+**  Rights:  Copyright (C) Christian Ensel 2010-2011
+**
+**  This software is provided 'as-is', without any express or implied warranty.
+**  In no event will the author be held liable for any damages arising from the
+**	use of this software. See host-odbc.c for the full license text.
+**
+*******************************************************************************/
+
+#ifndef HOST_ODBC_TEXT_H
+#define HOST_ODBC_TEXT_H
+
+#include <stddef.h>
+
+#if defined(_MSC_VER)
+#define TEXT_INLINE static __inline
+#else
+#define TEXT_INLINE static inline
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ODBC_TEXT_SSE2
+#include <emmintrin.h>
+#endif
+
+
+/*------------------------------------------------------------------------------
+**
+*/	TEXT_INLINE size_t Text_Utf16Length(const unsigned short *source, size_t max)
+/*
+**  Returns the number of units before the terminating NUL, at most MAX.
+**  Only used if the driver didn't tell the length (SQL_NO_TOTAL).
+**
+/*----------------------------------------------------------------------------*/
+{
+	size_t i;
+
+	for (i = 0; i < max && source[i]; i++);
+
+	return i;
+}
+
+
+/*------------------------------------------------------------------------------
+**
+*/	TEXT_INLINE int Text_Utf16IsLatin1(const unsigned short *source, size_t length)
+/*
+**  Returns TRUE if all units are below 0x100 and fit a byte-wide series.
+**
+/*----------------------------------------------------------------------------*/
+{
+	size_t         i = 0;
+	unsigned short bits = 0;
+#ifdef ODBC_TEXT_SSE2
+	__m128i        acc = _mm_setzero_si128();
+
+	for (; i < (length & ~(size_t)15); i += 16)
+	{
+		acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i *)(source + i)));
+		acc = _mm_or_si128(acc, _mm_loadu_si128((const __m128i *)(source + i + 8)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_srli_epi16(acc, 8), _mm_setzero_si128())) != 0xFFFF) return 0;
+	}
+#endif
+
+	for (; i < length; i++) bits |= source[i];
+
+	return bits < 0x100;
+}
+
+
+/*------------------------------------------------------------------------------
+**
+*/	TEXT_INLINE void Text_Utf16ToLatin1(unsigned char *target, const unsigned short *source, size_t length)
+/*
+**  Narrows units known to be below 0x100, see Text_Utf16IsLatin1.
+**
+/*----------------------------------------------------------------------------*/
+{
+	size_t i = 0;
+
+#ifdef ODBC_TEXT_SSE2
+	for (; i < (length & ~(size_t)15); i += 16)
+	{
+		_mm_storeu_si128((__m128i *)(target + i), _mm_packus_epi16(
+			_mm_loadu_si128((const __m128i *)(source + i)),
+			_mm_loadu_si128((const __m128i *)(source + i + 8))
+		));
+	}
+#endif
+
+	for (; i < length; i++) target[i] = (unsigned char)source[i];
+}
+
+
+/*------------------------------------------------------------------------------
+**
+*/	TEXT_INLINE void Text_Latin1ToUtf16(unsigned short *target, const unsigned char *source, size_t length)
+/*
+**  Widens byte-wide series data to UTF-16.
+**
+/*----------------------------------------------------------------------------*/
+{
+	size_t i = 0;
+
+#ifdef ODBC_TEXT_SSE2
+	__m128i bytes, zero = _mm_setzero_si128();
+
+	for (; i < (length & ~(size_t)15); i += 16)
+	{
+		bytes = _mm_loadu_si128((const __m128i *)(source + i));
+		_mm_storeu_si128((__m128i *)(target + i),     _mm_unpacklo_epi8(bytes, zero));
+		_mm_storeu_si128((__m128i *)(target + i + 8), _mm_unpackhi_epi8(bytes, zero));
+	}
+#endif
+
+	for (; i < length; i++) target[i] = source[i];
+}
+
+#endif
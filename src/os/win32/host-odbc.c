@@ -37,6 +37,10 @@
 
 #define REB_EXT
 #include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <locale.h>
 #include <reb-host.h>
 #include <host-lib.h>
 #include <sql.h>
@@ -45,11 +49,37 @@
 #define INCLUDE_EXT_DATA
 #include <host-ext-odbc.h>
 
+#include "host-odbc-text.h"
+
 #define MAKE_ERROR(txt) ODBC_MakeError(frm, ODBC_SqlWCharToString(txt))
 #define MAX_NUM_COLUMNS   255
 #define COLUMN_TITLE_SIZE 255
+#define MAX_SPARE_HANDLES 16
+#define MAX_BOUND_SIZE    8000                                                  // Larger columns are read with SQLGetData
+#define LONG_DATA_CHUNK   32768                                                 // Bytes per SQLGetData call on long columns
+#define ARENA_BLOCK_SIZE  4096                                                  // Initial arena size
+#define ARENA_MAX_KEPT    (1024 * 1024)                                         // Larger arenas shrink back on reset
+#define LATENCY_BUCKETS   16                                                    // Executions under 1, 2, 4 .. 16384 ms, and slower
+#define ASYNC_POLL_INTERVAL 10                                                  // Milliseconds between polls of asynchronous executions
+#define WM_ODBC_EXECUTED  (WM_APP + 0x0DBC)                                     // Posted when an asynchronous execution completed
+#define EXPORT_BUFFER_SIZE (1024 * 1024)                                        // Bytes written per WriteFile call by EXPORT-ODBC
+#define EXPORT_SCRATCH_SIZE (LONG_DATA_CHUNK * 2)                               // UTF-8 of one text value or chunk
 #define hnull SQL_NULL_HANDLE                                                   // Abbreviation
 
+#define ODBC_TRACE_TICKS() (ODBC_Tracing ? ODBC_Ticks() : 0)                    // Start of a traced call, see ODBC_TraceEvent
+#define ODBC_TRACE(name, id, start, rows, rc) do { \
+	if (ODBC_Tracing) ODBC_TraceEvent(name, id, start, rows, rc); \
+} while (0)                                                                     // Records a call, a single test while not tracing
+
+static SQLHENV ODBC_Env       = SQL_NULL_HANDLE;                                // Environment shared by all connections
+static int     ODBC_Env_Users = 0;
+static HWND    ODBC_Window    = NULL;                                           // Receives completions of asynchronous executions
+static LONGLONG ODBC_Frequency = 0;                                             // Performance counter ticks per second
+
+#define ODBC_COUNT(stats, counter, n) do { \
+	(stats)->counter += (n); if ((stats)->connection) (stats)->connection->counter += (n); \
+} while (0)                                                                     // Counts for the statement and its connection
+
 enum GET_CATALOG   {GET_CATALOG_TABLES, GET_CATALOG_COLUMNS, GET_CATALOG_TYPES};// Used with ODBC_GetCatalog
 enum FLATTEN_LEVEL {FLATTEN_NOT, FLATTEN_ONCE, FLATTEN_DEEP};                   // Used with ODBC_Flatten
 
@@ -59,23 +89,198 @@ typedef struct {
 	SQLLEN       size;
 	void        *buffer;
 	SQLLEN       length;
+	SQLLEN      *lengths;                                                       // Length/indicator array with parameter arrays
+	void        *data;                                                          // Bound across executions: BUFFER or series data
+	SQLLEN       bound;                                                         // Bytes bound at DATA
 } PARAMETER;
 
-typedef struct {                 												// For describing columns
-	SQLWCHAR     title[COLUMN_TITLE_SIZE];\
+typedef struct {                                                                // Parameters bound across executions, see ODBC_BindParameters
+	SQLHSTMT      hstmt;                                                        // Handle they're bound to, NULL once reset
+	int           count, capacity;
+	PARAMETER    *params;                                                       // CAPACITY + 1, numbered from 1 as the markers
+} BINDINGS;
+
+typedef struct COLUMN {          												// For describing columns
+	SQLWCHAR     title[COLUMN_TITLE_SIZE];
 	SQLSMALLINT  title_length;
 	SQLSMALLINT  sql_type;
 	SQLSMALLINT  c_type;
 	int          rebol_type;
 	SQLULEN      column_size;
-	SQLPOINTER   buffer;
-	SQLULEN      buffer_size;
-	SQLULEN      buffer_length;
+	SQLPOINTER   buffer;                                                        // Column-wise bound array, one element per rowset row
+	SQLULEN      buffer_size;                                                   // Size of one element
+	SQLLEN      *lengths;                                                       // Length/indicator array, one per rowset row
 	SQLSMALLINT  precision;
 	SQLSMALLINT  nullable;
+	int          unbound;                                                       // Read with SQLGetData after fetching
+	int          long_data;                                                     // Read in chunks of LONG_DATA_CHUNK bytes
+	int        (*convert)(struct COLUMN *column, char *buffer, SQLLEN length);  // Converter picked by ODBC_BindColumns
 	RXIARG       value;
 } COLUMN;
 
+typedef struct {                                                                // For block cursor fetching
+	SQLULEN       size;                                                         // Rows per SQLFetch (SQL_ATTR_ROW_ARRAY_SIZE)
+	SQLULEN       requested;                                                    // Rowset size asked for, driver may lower it
+	SQLULEN       fetched;                                                      // Rows in current rowset (SQL_ATTR_ROWS_FETCHED_PTR)
+	SQLULEN       row;                                                          // Next row of current rowset to hand out
+	SQLULEN       number;                                                       // Rows handed out since execution
+	int           unnumbered;                                                   // NUMBER unknown after scrolling, see ODBC_Scroll
+	SQLSMALLINT   num_columns;
+	SQLUSMALLINT *status;                                                       // Row status array (SQL_ATTR_ROW_STATUS_PTR)
+	int           result;                                                       // Columns are those of a later result, see ODBC_MoreResults
+} ROWSET;
+
+typedef struct {                                                                // One of the two rowset buffers of prefetching statements
+	void        **buffers;
+	SQLLEN      **lengths;
+	SQLUSMALLINT *status;
+	SQLULEN       fetched;
+} ROWSET_BUFFERS;
+
+typedef struct {                                                                // Fetches the next rowset while COPY converts the current one
+	SQLHSTMT        hstmt;
+	COLUMN         *columns;
+	ROWSET         *rowset;
+	ROWSET_BUFFERS  sets[2];                                                    // The first one's the bound rowset of the plan
+	int             front;                                                      // Set COLUMNS and ROWSET currently point to
+	int             bound;                                                      // Set the statement's bound to
+	HANDLE          thread, wake, ready;
+	int             busy, quit;
+	SQLRETURN       rc;
+} PREFETCH;
+
+typedef struct {                                                                // Column values staged by columnar COPY
+	int           rebol_type;                                                   // RXT_INTEGER, RXT_DECIMAL, RXT_BLOCK, RXT_END ends the array
+	SQLULEN       count, capacity;
+	void         *data;                                                         // Packed i64 or double values
+	REBSER       *block;                                                        // Values of RXT_BLOCK columns
+} STAGED;
+
+typedef struct STATS {                                                          // Performance counters of statements and connections
+	SQLULEN       prepares, executions, fetches, rows, bytes, hits, binds, allocated;
+	LONGLONG      prepare_time, execute_time, fetch_time, convert_time;         // Performance counter ticks
+	SQLULEN       latency[LATENCY_BUCKETS];                                     // Executions by duration
+	struct STATS *connection;                                                   // Counters of the statement's connection
+} STATS;
+
+typedef struct {                                                                // Traced ODBC call, see ODBC_TraceEvent
+	volatile ULONG sequence;                                                    // Event number + 1 once complete, 0 while written
+	const char   *name;
+	void         *id;                                                           // Statement or connection handle
+	LONGLONG      start, end;                                                   // Performance counter ticks
+	i64           rows;
+	SQLRETURN     rc;
+	DWORD         thread;
+} TRACE_EVENT;
+
+static TRACE_EVENT  *ODBC_Trace     = NULL;                                     // Ring buffer of traced calls, allocated once
+static ULONG         ODBC_TraceSize = 0;                                        // Power of two
+static volatile LONG ODBC_TraceNext = 0;                                        // Events recorded since tracing (re)started
+static volatile int  ODBC_Tracing   = FALSE;
+
+typedef struct {                                                                // Pending asynchronous execution
+	SQLHSTMT      hstmt;
+	REBSER       *port;                                                         // Notified by a READ event on completion
+	HANDLE        thread;                                                       // Worker thread, NULL if polling the driver
+	SQLRETURN     rc;
+	int           num_params, bind;
+	int           polling;                                                      // SQL_ATTR_ASYNC_ENABLE supported by the driver
+	volatile int  done, posted, delivered, orphaned;
+	LONGLONG      started, ended;
+} PENDING;
+
+typedef struct ARENA_BLOCK {                                                    // Chained arena memory
+	struct ARENA_BLOCK *next;
+	size_t        size, used;
+} ARENA_BLOCK;
+
+#define ARENA_HEADER ((sizeof(ARENA_BLOCK) + 15) & ~(size_t)15)
+
+typedef struct {                                                                // Per statement arena for per execution buffers
+	ARENA_BLOCK  *blocks;                                                       // Current block first
+	size_t        reserved;                                                     // Bytes in all blocks
+	size_t        used, peak;                                                   // Bytes handed out since reset, maximum thereof
+	u64           allocations;                                                  // Allocations served by the arena
+	u64           heap;                                                         // Heap allocations made for the statement
+	u64           resets;                                                       // Executions
+} ARENA;
+
+typedef struct {                                                                // Where long column values go
+	SQLLEN        limit;                                                        // Max bytes per value, 0 for no limit
+	REBSER       *directory;                                                    // LONG-TARGET directory as FILE!, or NULL
+	REBSER       *path;                                                         // LONG-TARGET directory as local path
+	ARENA        *arena;                                                        // Counts file buffer allocations
+	SQLULEN       bytes;                                                        // Counts bytes read
+} LONG_DATA;
+
+typedef struct {                                                                // Buffered CSV/TSV output of EXPORT-ODBC
+	HANDLE        file;
+	char         *buffer;
+	size_t        used;
+	char         *scratch;                                                      // UTF-8 of the text value at hand
+	char          delimiter[16];
+	int           delimiter_length;
+	char          null[64];                                                     // NULL rendering
+	int           null_length;
+	char          quote;                                                        // 0 for no quoting
+	LONGLONG      bytes;
+	int           error;                                                        // WriteFile failed
+} EXPORT;
+
+typedef struct {                                                                // CSV field read by IMPORT-ODBC, in the mapped file
+	const char   *start;
+	size_t        length;
+	int           quoted;                                                       // 1 if quoted, 2 if containing doubled quotes
+} CSV_FIELD;
+
+typedef struct {                                                                // Parameter arrays and batch of IMPORT-ODBC
+	PARAMETER    *params;
+	SQLSMALLINT   num_params;
+	SQLULEN       batch_size;
+	CSV_FIELD    *fields;                                                       // NUM_PARAMS fields per row of the batch
+	SQLULEN      *lines;                                                        // Line number per row of the batch
+	SQLULEN      *rows;                                                         // Batch row per parameter row executed
+	SQLUSMALLINT *status;
+	SQLULEN       processed;
+	char          quote;
+	char          null[64];                                                     // Unquoted text read as NULL
+	int           null_length;
+	char         *scratch;                                                      // Quoted field with doubled quotes undone
+	size_t        scratch_size;
+	STATS        *stats;
+	i64           loaded;
+	REBSER       *rejected;                                                     // Line numbers of rows not loaded
+	u32           num_rejected;
+} IMPORT;
+
+
+typedef struct {                                                                // Normalized statement text
+	u32           hash;
+	SQLINTEGER    length;
+	SQLULEN       cursor;                                                       // SQL_ATTR_CURSOR_TYPE it's prepared with
+	SQLWCHAR      chars[1];
+} SQLTEXT;
+
+typedef struct {                                                                // For caching prepared statements
+	SQLTEXT      *string;
+	SQLHSTMT      hstmt;
+	COLUMN       *columns;                                                      // Bound result set plan, if any
+	RXIARG       *values;
+	ROWSET       *rowset;
+	u32           used;                                                         // LRU clock value of last use
+} PREPARED;
+
+typedef struct {                                                                // Per connection LRU cache of prepared statements
+	SQLHDBC       hdbc;
+	int           capacity;                                                     // From the connection's STATEMENT-CACHE option
+	int           count, size;
+	PREPARED     *entries;
+	int           num_spare;
+	SQLHSTMT      spare[MAX_SPARE_HANDLES];                                     // Unprepared handles for reuse
+	u32           clock;
+	u64           hits, misses, evictions, reused;
+} PREPARED_CACHE;
+
 
 /******************************************************************************/
 void       Init_ODBC              (void);
@@ -86,22 +291,108 @@ void       ODBC_Flatten           (RXIARG *nest, RXIARG *flat, enum FLATTEN_LEVE
 	   int ODBC_StringToSqlWChar  (REBSER   *source, SQLWCHAR *target);
 	   int ODBC_UnCamelCase       (SQLWCHAR *source, SQLWCHAR *target);
 REBSER*    ODBC_SqlWCharToString  (SQLWCHAR *source);
+REBSER*    ODBC_SqlWCharsToString (SQLWCHAR *source, int length);
 REBSER*    ODBC_SqlBinaryToBinary (char     *source, int length);
 
-RXIEXT int ODBC_ConvertSqlToRebol (COLUMN *column);
+RXIEXT int ODBC_ConvertSqlToRebol (COLUMN *column, SQLULEN row);
+	   int ODBC_ConvertInteger    (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertBigint     (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertDouble     (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertDate       (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertTime       (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertTimestamp  (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertBit        (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertBinary     (COLUMN *column, char *buffer, SQLLEN length);
+	   int ODBC_ConvertText       (COLUMN *column, char *buffer, SQLLEN length);
 
 RXIEXT int ODBC_MakeError         (RXIFRM *frm, REBSER *description);
+RXIEXT int ODBC_MakeErrorId       (RXIFRM *frm, u32 id, REBSER *description);
 RXIEXT int ODBC_ReturnError       (RXIFRM *frm, SQLSMALLINT handleType, SQLHANDLE handle);
 void       ODBC_Close             (RXIFRM *frm); // conn, stmt
+void       ODBC_FreeColumns       (REBSER *statement);
+void       ODBC_FreePlan          (COLUMN *columns, RXIARG *values, ROWSET *rowset);
+
+ARENA*     ODBC_MakeArena         (void);
+void*      ODBC_Alloc             (ARENA *arena, size_t size);
+void       ODBC_ResetArena        (ARENA *arena);
+void       ODBC_FreeArena         (ARENA *arena);
+
+SQLTEXT*   ODBC_NormalizeSql      (ARENA *arena, REBSER *source);
+SQLTEXT*   ODBC_KeepSql           (SQLTEXT *text);
+PREPARED_CACHE* ODBC_GetCache     (REBSER *statement);
+void       ODBC_ParkStatement     (PREPARED_CACHE *cache, REBSER *statement);
+SQLRETURN  ODBC_RenewStatement    (PREPARED_CACHE *cache, REBSER *statement, SQLHSTMT *hstmt);
+SQLRETURN  ODBC_PrepareCached     (PREPARED_CACHE *cache, REBSER *statement, SQLTEXT *string, SQLHSTMT *hstmt, int *bind);
+void       ODBC_FreeCache         (PREPARED_CACHE *cache);
+RXIEXT int ODBC_Query             (RXIFRM *frm);
+RXIEXT int ODBC_Stats             (RXIFRM *frm);
+STATS     *ODBC_GetStats          (REBSER *object);
+LONGLONG   ODBC_Ticks             (void);
+i64        ODBC_TicksToNanoseconds(LONGLONG ticks);
+void       ODBC_CountExecution    (STATS *stats, LONGLONG ticks);
+void       ODBC_TraceEvent        (const char *name, void *id, LONGLONG start, i64 rows, SQLRETURN rc);
+RXIEXT int ODBC_TraceStart        (RXIFRM *frm);
+RXIEXT int ODBC_TraceDump         (RXIFRM *frm);
 RXIEXT int ODBC_OpenDb            (RXIFRM *frm);
 RXIEXT int ODBC_OpenSql           (RXIFRM *frm);
+RXIEXT int ODBC_Update            (RXIFRM *frm);
+RXIEXT int ODBC_EndTran           (RXIFRM *frm);
+RXIEXT int ODBC_Autocommit        (RXIFRM *frm);
+RXIEXT int ODBC_Reset             (RXIFRM *frm);
+RXIEXT int ODBC_Ping              (RXIFRM *frm);
 RXIEXT int ODBC_Insert            (RXIFRM *frm);
+SQLRETURN  ODBC_SetQueryTimeout   (REBSER *object, SQLHSTMT hstmt);
+RXIEXT int ODBC_Cancel            (RXIFRM *frm);
+	   int ODBC_PrepareSql        (RXIFRM *frm, REBSER *object, ARENA *arena, STATS *stats, REBSER *sql, SQLHSTMT *hstmt, int *bind);
+RXIEXT int ODBC_DescribeResult    (RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, ARENA *arena, int bind);
+RXIEXT int ODBC_ExecuteAsync      (RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, int execute, int num_params, int bind);
+DWORD WINAPI ODBC_ExecuteThread   (void *task);
+LRESULT CALLBACK ODBC_WindowProc  (HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam);
+RXIEXT int ODBC_Finish            (RXIFRM *frm);
+RXIEXT int ODBC_MoreResults       (RXIFRM *frm);
+RXIEXT int ODBC_Scroll            (RXIFRM *frm);
+void       ODBC_FreePending       (REBSER *statement);
 RXIEXT int ODBC_Copy              (RXIFRM *frm);
-
-SQLRETURN  ODBC_BindParameter     (RXIFRM *frm, SQLHSTMT hstmt, PARAMETER *params, int p, int type);
+	   int ODBC_NextRow           (RXIFRM *frm, SQLHSTMT hstmt, ROWSET *rowset, PREFETCH *prefetch, STATS *stats);
+	   int ODBC_ConvertRow        (RXIFRM *frm, SQLHSTMT hstmt, COLUMN *columns, ROWSET *rowset, LONG_DATA *long_data, REBSER *record);
+RXIEXT int ODBC_Fetch             (RXIFRM *frm);
+RXIEXT int ODBC_Export            (RXIFRM *frm);
+	   int ODBC_ExportValue       (EXPORT *export, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column, SQLULEN row);
+	   int ODBC_ExportLongValue   (EXPORT *export, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column);
+void       ODBC_ExportText        (EXPORT *export, SQLWCHAR *text, int units, int quote);
+void       ODBC_ExportBytes       (EXPORT *export, char *bytes, size_t length, int quote);
+char      *ODBC_ExportReserve     (EXPORT *export, size_t length);
+void       ODBC_ExportFlush       (EXPORT *export);
+	   int ODBC_FormatDigits      (char *target, unsigned long value, int width);
+	   int ODBC_FormatTimestamp   (char *target, TIMESTAMP_STRUCT *timestamp, int digits);
+	   int ODBC_FormatDouble      (char *target, double value);
+RXIEXT int ODBC_Import            (RXIFRM *frm);
+	   int ODBC_ImportBatch       (RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, IMPORT *import, SQLULEN count);
+	   int ODBC_ParseRecord       (const char **position, const char *end, char delimiter, char quote, CSV_FIELD *fields, int max_fields, SQLULEN *lines);
+	   int ODBC_FormatInteger     (char *target, i64 value);
+RXIEXT int ODBC_CopyColumns       (RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, COLUMN *columns, ROWSET *rowset, PREFETCH *prefetch, STATS *stats, LONG_DATA *long_data, i32 num_rows);
+PREFETCH  *ODBC_StartPrefetch     (REBSER *object, SQLHSTMT hstmt, ARENA *arena, COLUMN *columns, ROWSET *rowset);
+SQLRETURN  ODBC_FetchAhead        (PREFETCH *prefetch);
+DWORD WINAPI ODBC_PrefetchThread  (void *data);
+SQLRETURN  ODBC_BindRowsetBuffers (PREFETCH *prefetch, int set, SQLULEN *fetched);
+SQLULEN    ODBC_StopPrefetch      (REBSER *statement);
+	   int ODBC_UnstageColumn     (STAGED *stage, REBSER *result, int col);
+RXIEXT int ODBC_FillVectors       (RXIFRM *frm);
+void       ODBC_FreeStaged        (REBSER *statement);
+
+	   int ODBC_BindParameters    (RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, STATS *stats, REBSER *arguments, int num_params);
+void       ODBC_ResetParameters   (REBSER *statement, SQLHSTMT hstmt);
+void       ODBC_FreeBindings      (REBSER *statement);
+SQLRETURN  ODBC_BindParameterArray(RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, PARAMETER *param, int p, SQLULEN rows);
+void       ODBC_SetParameterValue (PARAMETER *param, SQLULEN row, RXIARG *value, int type);
+RXIEXT int ODBC_ExecuteBulk       (RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, REBSER *object, REBSER *rows, u32 index);
 SQLRETURN  ODBC_GetCatalog        (RXIFRM *frm, SQLHSTMT hstmt, enum GET_CATALOG which, REBSER *block);
 SQLRETURN  ODBC_DescribeResults   (RXIFRM *frm, SQLHSTMT hstmt, int num_columns, COLUMN *columns, REBSER *titles);
-SQLRETURN  ODBC_BindColumns       (RXIFRM *frm, SQLHSTMT hstmt, int num_columns, COLUMN *columns, RXIARG *values);
+void       ODBC_MakeTitles        (int num_columns, COLUMN *columns, REBSER *titles);
+SQLRETURN  ODBC_BindColumns       (RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, int num_columns, COLUMN *columns, ROWSET *rowset);
+	   int ODBC_IsLongColumn      (COLUMN *column);
+	   int ODBC_GetData           (RXIFRM *frm, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column, LONG_DATA *target, SQLULEN number);
+	   int ODBC_GetLongData       (RXIFRM *frm, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column, LONG_DATA *target, SQLULEN number);
 /******************************************************************************/
 
 
@@ -164,13 +455,61 @@ RL_LIB *RL;
 		case CMD_ODBC_UPDATE_ODBC:
 			return ODBC_Update(frm);
 
+		case CMD_ODBC_END_ODBC:
+			return ODBC_EndTran(frm);
+
+		case CMD_ODBC_AUTOCOMMIT_ODBC:
+			return ODBC_Autocommit(frm);
+
+		case CMD_ODBC_FINISH_ODBC:
+			return ODBC_Finish(frm);
+
 		case CMD_ODBC_COPY_ODBC:
 			return ODBC_Copy(frm);
 
+		case CMD_ODBC_MORE_ODBC:
+			return ODBC_MoreResults(frm);
+
+		case CMD_ODBC_SCROLL_ODBC:
+			return ODBC_Scroll(frm);
+
+		case CMD_ODBC_CANCEL_ODBC:
+			return ODBC_Cancel(frm);
+
+		case CMD_ODBC_TRACE_ODBC:
+			return ODBC_TraceStart(frm);
+
+		case CMD_ODBC_TRACE_DUMP_ODBC:
+			return ODBC_TraceDump(frm);
+
+		case CMD_ODBC_FILL_ODBC:
+			return ODBC_FillVectors(frm);
+
+		case CMD_ODBC_FETCH_ODBC:
+			return ODBC_Fetch(frm);
+
+		case CMD_ODBC_EXPORT_ODBC:
+			return ODBC_Export(frm);
+
+		case CMD_ODBC_IMPORT_ODBC:
+			return ODBC_Import(frm);
+
 		case CMD_ODBC_CLOSE_ODBC:
 			ODBC_Close(frm);
 			return RXR_NO_COMMAND;
 
+		case CMD_ODBC_QUERY_ODBC:
+			return ODBC_Query(frm);
+
+		case CMD_ODBC_STATS_ODBC:
+			return ODBC_Stats(frm);
+
+		case CMD_ODBC_RESET_ODBC:
+			return ODBC_Reset(frm);
+
+		case CMD_ODBC_PING_ODBC:
+			return ODBC_Ping(frm);
+
 		case CMD_ODBC_FLATTEN:
 			nest        = RXA_ARG(frm, 1);
 			flat.series = RL_MAKE_BLOCK(RL_SERIES(nest.series, RXI_SER_TAIL));
@@ -225,13 +564,28 @@ RL_LIB *RL;
 **
 */  int ODBC_StringToSqlWChar(REBSER *source, SQLWCHAR *target)
 /*
+**  Copies the series data in one pass, byte-wide (Latin-1) data is widened.
+**
 /*----------------------------------------------------------------------------*/
 {
-	int i;
+	int   i, length = RL_SERIES(source, RXI_SER_TAIL);
+	void *data      = (void *)RL_SERIES(source, RXI_SER_DATA);
+
+	switch (RL_SERIES(source, RXI_SER_WIDE))
+	{
+		case 1:
+			Text_Latin1ToUtf16((unsigned short *)target, (unsigned char *)data, length);
+			break;
 
-	for (i = 0; i < RL_SERIES(source, RXI_SER_TAIL); i++) target[i] = RL_GET_CHAR(source, i);
+		case sizeof(SQLWCHAR):
+			memcpy(target, data, length * sizeof(SQLWCHAR));
+			break;
+
+		default:
+			for (i = 0; i < length; i++) target[i] = RL_GET_CHAR(source, i);
+	}
 
-	return i;
+	return length;
 }
 
 
@@ -241,8 +595,40 @@ RL_LIB *RL;
 /*
 /*----------------------------------------------------------------------------*/
 {
-	int     i, length = lstrlenW(source);
-	REBSER *target = RL_MAKE_STRING(length, TRUE); // UTF-8 for REBOL3
+	return ODBC_SqlWCharsToString(source, lstrlenW(source));
+}
+
+
+/*------------------------------------------------------------------------------
+**
+*/	REBSER* ODBC_SqlWCharsToString(SQLWCHAR *source, int length)
+/*
+**  Makes a byte-wide string if all chars are Latin-1, a wide one otherwise,
+**  and fills it in one pass if the host returns series sized to LENGTH. R3's
+**  RL_MAKE_STRING returns empty series, so these are filled in per char.
+**
+/*----------------------------------------------------------------------------*/
+{
+	int     i, latin1 = Text_Utf16IsLatin1((unsigned short *)source, length);
+	REBSER *target    = RL_MAKE_STRING(length, !latin1);
+	void   *data;
+
+	if (RL_SERIES(target, RXI_SER_TAIL) == length)
+	{
+		data = (void *)RL_SERIES(target, RXI_SER_DATA);
+
+		switch (RL_SERIES(target, RXI_SER_WIDE))
+		{
+			case 1:
+				if (!latin1) break;
+				Text_Utf16ToLatin1((unsigned char *)data, (unsigned short *)source, length);
+				return target;
+
+			case sizeof(SQLWCHAR):
+				memcpy(data, source, length * sizeof(SQLWCHAR));
+				return target;
+		}
+	}
 
 	for (i = 0; i < length; i++) RL_SET_CHAR(target, i, source[i]);
 
@@ -259,7 +645,13 @@ RL_LIB *RL;
 	int     i;
 	REBSER *target = RL_MAKE_STRING(length, FALSE);
 
-	for (i = 0; i < length; i++) RL_SET_CHAR(target, i, source[i]);
+	if (RL_SERIES(target, RXI_SER_TAIL) == length)                              // Fill in one pass if the host sized the series
+	{
+		memcpy((void *)RL_SERIES(target, RXI_SER_DATA), source, length);
+		return target;
+	}
+
+	for (i = 0; i < length; i++) RL_SET_CHAR(target, i, (unsigned char)source[i]);
 
 	return target;
 }
@@ -296,6 +688,19 @@ RL_LIB *RL;
 */	RXIEXT int ODBC_MakeError(RXIFRM *frm, REBSER *description)
 /*
 *******************************************************************************/
+{
+	return ODBC_MakeErrorId(frm, RL_MAP_WORD("error"), description);
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_MakeErrorId(RXIFRM *frm, u32 id, REBSER *description)
+/*
+**  Returns the [odbc id [description]] block the scheme raises as an error
+**  of the ODBC error catalog, see odbc.r3.
+**
+*******************************************************************************/
 {
 	REBSER *block, *args;
 	RXIARG  value;
@@ -304,7 +709,7 @@ RL_LIB *RL;
 	args  = RL_MAKE_BLOCK(1);
 
 	value.int32a = RL_MAP_WORD("odbc");	 RL_SET_VALUE(block, 0, value, RXT_LIT_WORD);
-	value.int32a = RL_MAP_WORD("error"); RL_SET_VALUE(block, 1, value, RXT_LIT_WORD);
+	value.int32a = id;					 RL_SET_VALUE(block, 1, value, RXT_LIT_WORD);
 	value.series = description;			 RL_SET_VALUE(args,  0, value, RXT_STRING);
 	value.series = args;				 RL_SET_VALUE(block, 2, value, RXT_BLOCK);
 
@@ -320,6 +725,10 @@ RL_LIB *RL;
 **
 */	RXIEXT int ODBC_ReturnError(RXIFRM *frm, SQLSMALLINT handleType, SQLHANDLE handle)
 /*
+**  Returns the first diagnostic record of HANDLE as an error. Timeouts
+**  (SQLSTATE HYT00, HYT01) are raised as ODBC TIMEOUT errors and canceled
+**  executions (HY008) as ODBC CANCELED errors, anything else as ODBC ERROR.
+**
 *******************************************************************************/
 {
 	RXIARG       value;
@@ -328,14 +737,22 @@ RL_LIB *RL;
 	SQLINTEGER	 native;
 	SQLSMALLINT  buffer = 4086, message_len = 0;
 	SQLRETURN	 rc;
+	u32          id;
 
 	value.series = (REBSER *)ODBC_SqlWCharToString(L"unknown error");
 	value.index  = 0;
+	id           = RL_MAP_WORD("error");
 
 	rc = SQLGetDiagRecW(handleType, handle, 1, state, &native, message, buffer, &message_len);
-	if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) value.series = (REBSER *)ODBC_SqlWCharToString(message);
+	if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)
+	{
+		value.series = (REBSER *)ODBC_SqlWCharToString(message);
+
+		if      (!memcmp(state, L"HYT00", 5 * sizeof(SQLWCHAR)) || !memcmp(state, L"HYT01", 5 * sizeof(SQLWCHAR))) id = RL_MAP_WORD("timeout");
+		else if (!memcmp(state, L"HY008", 5 * sizeof(SQLWCHAR)))                                               id = RL_MAP_WORD("canceled");
+	}
 
-	return ODBC_MakeError(frm, value.series);
+	return ODBC_MakeErrorId(frm, id, value.series);
 }
 
 
@@ -350,20 +767,46 @@ RL_LIB *RL;
 	SQLHENV 	 henv;
 	SQLHDBC 	 hdbc;
 	SQLHSTMT	 hstmt;
-	COLUMN      *columns;
+	SQLTEXT     *string;
+	PREPARED_CACHE *cache;
 	int          type;
 
 	if (RXA_TYPE(frm, 2) == RXT_OBJECT)
 	{
 		statement = RXA_OBJECT(frm, 2);
 
+		ODBC_FreePending(statement);											// Cancels a running execution
+		ODBC_StopPrefetch(statement);
+
+		if (RL_GET_FIELD(statement, RL_MAP_WORD("arena"), &value) == RXT_HANDLE)
+		{
+			ODBC_FreeArena(value.addr);
+			RL_SET_FIELD(statement, RL_MAP_WORD("arena"), value, RXT_NONE);
+		}
+
+		ODBC_FreeStaged(statement);
+
+		if (RL_GET_FIELD(statement, RL_MAP_WORD("stats"), &value) == RXT_HANDLE)
+		{
+			free(value.addr);
+			RL_SET_FIELD(statement, RL_MAP_WORD("stats"), value, RXT_NONE);
+		}
+
+		ODBC_FreeBindings(statement);
+
+		if ((cache = ODBC_GetCache(statement)))									// Keep handle and prepared statement for reuse
+		{
+			ODBC_ParkStatement(cache, statement);
+			return;
+		}
+
 		hstmt   = (RL_GET_FIELD(statement, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
-		columns = (RL_GET_FIELD(statement, RL_MAP_WORD("columns"),   &value) == RXT_HANDLE) ? value.addr : NULL;
-		values  = (RL_GET_FIELD(statement, RL_MAP_WORD("values"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+		string  = (RL_GET_FIELD(statement, RL_MAP_WORD("string"),    &value) == RXT_HANDLE) ? value.addr : NULL;
 
 		if (hstmt)   SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
-		if (columns) free(columns);
-		if (values)  free(values);
+		if (string)  free(string);
+
+		ODBC_FreeColumns(statement);
 
 		return;
 	}
@@ -372,18 +815,74 @@ RL_LIB *RL;
 	{
 		connection = RXA_OBJECT(frm, 1);
 
-		henv = (RL_GET_FIELD(connection, RL_MAP_WORD("environment"), &value) == RXT_HANDLE) ? value.addr : NULL;
-		hdbc = (RL_GET_FIELD(connection, RL_MAP_WORD("connection"),  &value) == RXT_HANDLE) ? value.addr : NULL;
+		henv  = (RL_GET_FIELD(connection, RL_MAP_WORD("environment"), &value) == RXT_HANDLE) ? value.addr : NULL;
+		hdbc  = (RL_GET_FIELD(connection, RL_MAP_WORD("connection"),  &value) == RXT_HANDLE) ? value.addr : NULL;
+		cache = (RL_GET_FIELD(connection, RL_MAP_WORD("prepared"),    &value) == RXT_HANDLE) ? value.addr : NULL;
 
+		if (RL_GET_FIELD(connection, RL_MAP_WORD("stats"), &value) == RXT_HANDLE) free(value.addr);
+
+		if (cache) ODBC_FreeCache(cache);
 		if (hdbc) SQLDisconnect(hdbc);
 		if (hdbc) SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
-		if (henv) SQLFreeHandle(SQL_HANDLE_ENV, henv);
+
+		if (henv && henv == ODBC_Env && --ODBC_Env_Users == 0)					// Last connection closed
+		{
+			SQLFreeHandle(SQL_HANDLE_ENV, ODBC_Env);
+			ODBC_Env = SQL_NULL_HANDLE;
+		}
 
 		return;
 	}
 }
 
 
+/*******************************************************************************
+**
+*/	void ODBC_FreeColumns(REBSER *statement)
+/*
+**  Frees the column descriptions, their bound rowset buffers and the rowset
+**  of a statement object.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	COLUMN      *columns;
+	RXIARG      *values;
+	ROWSET      *rowset;
+
+	columns = (RL_GET_FIELD(statement, RL_MAP_WORD("columns"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	values  = (RL_GET_FIELD(statement, RL_MAP_WORD("values"),  &value) == RXT_HANDLE) ? value.addr : NULL;
+	rowset  = (RL_GET_FIELD(statement, RL_MAP_WORD("rowset"),  &value) == RXT_HANDLE) ? value.addr : NULL;
+
+	ODBC_FreePlan(columns, values, rowset);
+
+	RL_SET_FIELD(statement, RL_MAP_WORD("columns"), value, RXT_NONE);
+	RL_SET_FIELD(statement, RL_MAP_WORD("values"),  value, RXT_NONE);
+	RL_SET_FIELD(statement, RL_MAP_WORD("rowset"),  value, RXT_NONE);
+	RL_SET_FIELD(statement, RL_MAP_WORD("titles"),  value, RXT_NONE);
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_FreePlan(COLUMN *columns, RXIARG *values, ROWSET *rowset)
+/*
+*******************************************************************************/
+{
+	int          col;
+
+	if (columns && rowset) for (col = 0; col < rowset->num_columns; col++)
+	{
+		if (columns[col].buffer)  free(columns[col].buffer);
+		if (columns[col].lengths) free(columns[col].lengths);
+	}
+
+	if (columns) free(columns);
+	if (values)  free(values);
+	if (rowset)  free(rowset);
+}
+
+
 /*******************************************************************************
 **
 */	RXIEXT int ODBC_OpenDb(RXIFRM *frm)
@@ -391,6 +890,11 @@ RL_LIB *RL;
 **		Opens a ODBC connection, returns handles to henv and hdbc as an
 **		object which is to be passed to consecuting functions.
 **
+**		All connections share one environment handle, which is freed with
+**		the last connection closed.
+**
+**		The third argument is the login timeout in seconds, 0 for none.
+**
 *******************************************************************************/
 {
 	SQLHENV 	 henv;
@@ -401,6 +905,8 @@ RL_LIB *RL;
 	i32      	 length, in;
 	REBSER      *string, *database;
 	RXIARG	     value;
+	PREPARED_CACHE *cache;
+	LONGLONG     ticks;
 	int          type, error;
 
 	database = RXA_OBJECT(frm, 1);
@@ -412,53 +918,79 @@ RL_LIB *RL;
 
 	ODBC_StringToSqlWChar(string, connect);
 
-	rc = SQLAllocHandle(SQL_HANDLE_ENV, hnull, &henv);                          // Allocate the environment handle
-	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_ENV, SQL_NULL_HENV);
+	if (ODBC_Env == SQL_NULL_HANDLE)											// Allocate the shared environment handle
+	{
+		rc = SQLAllocHandle(SQL_HANDLE_ENV, hnull, &henv);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
+		{
+			free(connect);
+			return ODBC_ReturnError(frm, SQL_HANDLE_ENV, SQL_NULL_HENV);
+		}
 
-	value.addr = henv;
-	RL_SET_FIELD(database, RL_MAP_WORD("environment"), value, RXT_HANDLE);
+		rc = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3, 0);	// Set the ODBC3 version environment attribute
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
+		{
+			free(connect);
+			error = ODBC_ReturnError(frm, SQL_HANDLE_ENV, henv);
+			SQLFreeHandle(SQL_HANDLE_ENV, henv);
+			return error;
+		}
 
-	rc = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (void*)SQL_OV_ODBC3, 0);	// Set the ODBC3 version environment attribute
-	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
-	{
-		error = ODBC_ReturnError(frm, SQL_HANDLE_ENV, henv);
-		SQLFreeHandle(SQL_HANDLE_ENV, henv);
-		return error;
+		ODBC_Env = henv;
 	}
 
+	henv = ODBC_Env;
+
 	rc = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);							// Allocate the connection handle
 	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
 	{
-		error = ODBC_ReturnError(frm, SQL_HANDLE_ENV, henv);
-		SQLFreeHandle(SQL_HANDLE_ENV, henv);
-		return error;
+		free(connect);
+		return ODBC_ReturnError(frm, SQL_HANDLE_ENV, henv);
 	}
 
-	value.addr = hdbc;
-	RL_SET_FIELD(database, RL_MAP_WORD("connection"), value, RXT_HANDLE);
-
-	rc = SQLSetConnectAttr(hdbc, SQL_LOGIN_TIMEOUT, (SQLPOINTER)5, 0);			// Set login timeout to 5 seconds (why 5?)
+	rc = SQLSetConnectAttr(hdbc, SQL_LOGIN_TIMEOUT, (SQLPOINTER)(SQLULEN)RXA_INT64(frm, 3), 0);
 	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
 	{
-		error = ODBC_ReturnError(frm, SQL_HANDLE_ENV, henv);
+		free(connect);
+		error = ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
 		SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
-		SQLFreeHandle(SQL_HANDLE_ENV, henv);
 		return error;
 	}
 
+	ticks = ODBC_TRACE_TICKS();
+
 	rc = SQLDriverConnectW(hdbc, NULL, 											// Connect to the Driver
 			(SQLWCHAR*)connect, length, NULL, 0, &out, SQL_DRIVER_NOPROMPT
 	);
+	ODBC_TRACE("SQLDriverConnect", hdbc, ticks, 0, rc);
 	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
 	{
-		error = ODBC_ReturnError(frm, SQL_HANDLE_ENV, henv);
+		free(connect);
+		error = ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
 		SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
-		SQLFreeHandle(SQL_HANDLE_ENV, henv);
 		return error;
 	}
 
+	ODBC_Env_Users++;
+
+	value.addr = henv;
+	RL_SET_FIELD(database, RL_MAP_WORD("environment"), value, RXT_HANDLE);
+	value.addr = hdbc;
+	RL_SET_FIELD(database, RL_MAP_WORD("connection"),  value, RXT_HANDLE);
+
 	free(connect);
 
+	cache = calloc(1, sizeof(PREPARED_CACHE));									// Allocate the prepared statement cache
+	if (cache == NULL) return MAKE_ERROR(L"Couldn't allocate statement cache!");
+
+	cache->hdbc = hdbc;
+	value.addr  = cache;
+	RL_SET_FIELD(database, RL_MAP_WORD("prepared"), value, RXT_HANDLE);
+
+	value.addr  = calloc(1, sizeof(STATS));										// Allocate the performance counters
+	if (value.addr == NULL) return MAKE_ERROR(L"Couldn't allocate statistics!");
+	RL_SET_FIELD(database, RL_MAP_WORD("stats"), value, RXT_HANDLE);
+
 	return RXR_TRUE;
 }
 
@@ -474,6 +1006,9 @@ RL_LIB *RL;
 	SQLRETURN    rc;
 	REBSER      *database, *statement;
 	RXIARG       value;
+	PREPARED_CACHE *cache;
+	ARENA       *arena;
+	STATS       *stats;
 	int          type;
 
 	database  = RXA_OBJECT(frm, 1);
@@ -482,688 +1017,4578 @@ RL_LIB *RL;
 	type = RL_GET_FIELD(database, RL_MAP_WORD("connection"), &value);			// Get connection handle
 	if (type != RXT_HANDLE) return MAKE_ERROR(L"Invalid connection argument!");
 
-	hdbc = value.addr;
+	hdbc  = value.addr;
+	cache = (RL_GET_FIELD(database, RL_MAP_WORD("prepared"), &value) == RXT_HANDLE) ? value.addr : NULL;
 
-	rc = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);							// Allocate the statement handle
-	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+	if (cache && cache->num_spare > 0)											// Reuse a statement handle
+	{
+		hstmt = cache->spare[--cache->num_spare];
+		cache->reused++;
+	}
+	else
+	{
+		rc = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);						// Allocate the statement handle
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+	}
 
 	value.addr = hstmt;
 	RL_SET_FIELD(statement, RL_MAP_WORD("statement"), value, RXT_HANDLE);
 
-	return RXR_TRUE;
-}
+	arena = ODBC_MakeArena();
+	if (arena == NULL) return MAKE_ERROR(L"Couldn't allocate statement arena!");
 
-//a: b: c: 0 dt [loop 512 [cache:      open odbc://cachesamples a: a + 1                               close cache      b: b + 1]]
-//a: b: c: 0 dt [loop 512 [cache:      open odbc://cachesamples a: a + 1 db: first cache      b: b + 1 close cache      c: c + 1]]
-//dbs: [] a: 0 dt [cache: open odbc://cachesamples loop 512 [append dbs first cache a: a + 1] close cache]
+	value.addr = arena;
+	RL_SET_FIELD(statement, RL_MAP_WORD("arena"), value, RXT_HANDLE);
 
-//a: b: c: 0 dt [loop 512 [postgresql: open odbc://pgsamples    a: a + 1                               close postgresql b: b + 1]]
-//a: b: c: 0 dt [loop 512 [postgresql: open odbc://pgsamples    a: a + 1 db: first postgresql b: b + 1 close postgresql c: c + 1]]
+	stats = calloc(1, sizeof(STATS));
+	if (stats == NULL) return MAKE_ERROR(L"Couldn't allocate statistics!");
+
+	stats->connection = ODBC_GetStats(database);
+	value.addr = stats;
+	RL_SET_FIELD(statement, RL_MAP_WORD("stats"), value, RXT_HANDLE);
+
+	return RXR_TRUE;
+}
 
 
 /*******************************************************************************
 **
-*/	RXIEXT int ODBC_Update(RXIFRM *frm)
+*/	ARENA* ODBC_MakeArena(void)
 /*
+**  Makes an empty arena, its first block is allocated on first use.
+**
 *******************************************************************************/
 {
-	SQLHDBC      hdbc;
-	SQLRETURN    rc;
-	RXIARG       value;
-	REBSER      *database;
-	i64          access, commit;
-	int          type;
-
-	database  = RXA_OBJECT(frm, 1);
-	access    = RXA_LOGIC (frm, 2);
-	commit    = RXA_LOGIC (frm, 3);
-
-	type = RL_GET_FIELD(database, RL_MAP_WORD("connection"), &value);			// Get connection handle
-	if (type != RXT_HANDLE) return MAKE_ERROR(L"Invalid connection argument!");
-
-	hdbc = value.addr;
-
-	rc = SQLSetConnectAttr(hdbc, SQL_ATTR_ACCESS_MODE, (SQLPOINTER *)(access ? SQL_MODE_READ_WRITE : SQL_MODE_READ_ONLY), SQL_IS_UINTEGER);							// Allocate the statement handle
-	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
-
-	rc = SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT,  (SQLPOINTER *)(commit ? SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF), SQL_IS_UINTEGER);							// Allocate the statement handle
-	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
-
-	return RXR_TRUE;
+	return calloc(1, sizeof(ARENA));
 }
 
 
 /*******************************************************************************
 **
-*/	SQLRETURN ODBC_BindParameter(RXIFRM *frm, SQLHSTMT hstmt, PARAMETER *params, int p, int rebol_type)
+*/	void* ODBC_Alloc(ARENA *arena, size_t size)
 /*
-**	Arguments:
-**		params - buffer where to store bound parameter values (to not conflict
-**               wiith being gc'ed on the REBOL side)
-**
-**  The buffer at *ParameterValuePtr SQLBindParameter binds to is deferred
-**  buffer, and so is the StrLen_or_IndPtr. They need to be vaild over until
-**  Execute or ExecDirect are called.
+**  Returns SIZE bytes (16-byte aligned) from the arena, valid until the
+**  arena is reset. Adds a block twice the size of the current one if it
+**  is exhausted.
 **
 *******************************************************************************/
 {
-	int          tail, hour, minute, second, i;
-	REBSER      *series;
-	TIME_STRUCT *time;
-	DATE_STRUCT	*date;
-	WCHAR		*chars;
-	char        *bytes;
-	SQLSMALLINT  c_type, sql_type;
-	SQLPOINTER   param;
-	SQLLEN       buffer_size;
-	SQLLEN       length = 0, column_size;
-	SQLRETURN    rc;
+	ARENA_BLOCK *block = arena->blocks;
+	size_t       want;
+	char        *memory;
 
-	buffer_size 	 	 = 0;
-	params[p].length 	 = 0;
-	params[p].size   	 = 0;
-	params[p].rebol_type = rebol_type;
+	size = (size + 15) & ~(size_t)15;
 
-	switch (rebol_type)
+	if (block == NULL || block->used + size > block->size)
 	{
-		case RXT_TIME:
-			time = malloc(sizeof(TIME_STRUCT));
+		want = block ? block->size * 2 : ARENA_BLOCK_SIZE;
+		if (want < size) want = size;
 
-			time->hour   = (params[p].value.int64 / 3.6e12);
-			time->minute = (params[p].value.int64 - (time->hour * 3.6e12)) / 6e10;
-			time->second = (params[p].value.int64 - (time->hour * 3.6e12) - (time->minute * 60e9)) / 1000e6;
+		block = malloc(ARENA_HEADER + want);
+		if (block == NULL) return NULL;
 
-			column_size = sizeof(TIME_STRUCT);
-			params[p].buffer = time;
-			params[p].size   = column_size;
-			params[p].length = column_size;
-			break;
+		block->next = arena->blocks;
+		block->size = want;
+		block->used = 0;
 
-		case RXT_DATE:
-			date = malloc(sizeof(DATE_STRUCT));
+		arena->blocks    = block;
+		arena->reserved += want;
+		arena->heap++;
+	}
 
-			date->year   = (params[p].value.int32a & 1073676288) >> 16;
-			date->month  = (params[p].value.int32a & 	  61440) >> 12;
-			date->day    = (params[p].value.int32a &       3968) >>  7;
+	memory = (char *)block + ARENA_HEADER + block->used;
+	block->used += size;
 
-			column_size = sizeof(DATE_STRUCT);
-			params[p].buffer = date;
-			params[p].size   = column_size;
-			params[p].length = column_size;
-			break;
+	arena->used += size;
+	if (arena->used > arena->peak) arena->peak = arena->used;
+	arena->allocations++;
 
-		case RXT_STRING:
-			series = params[p].value.series;
-			tail   = RL_SERIES(series, RXI_SER_TAIL);
+	return memory;
+}
 
-			buffer_size = sizeof(SQLWCHAR) * tail;
-			chars  		= malloc(buffer_size);
-			if (chars == NULL) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
 
-			length 		= ODBC_StringToSqlWChar(series, chars);
-			column_size = 2 * length;
+/*******************************************************************************
+**
+*/	void ODBC_ResetArena(ARENA *arena)
+/*
+**  Releases all allocations at once. Arenas grown to several blocks are
+**  coalesced into one block of their total size, so that executing the same
+**  statement again is served without heap allocations. Arenas larger than
+**  ARENA_MAX_KEPT (after huge bulk inserts) start over small.
+**
+*******************************************************************************/
+{
+	ARENA_BLOCK *block, *next;
+	size_t       size;
 
-			params[p].buffer = chars;
-			params[p].size   = column_size;
-			params[p].length = column_size;
-			break;
+	arena->used = 0;
+	arena->resets++;
 
-		case RXT_BINARY:
-			series = params[p].value.series;
-			tail   = RL_SERIES(series, RXI_SER_TAIL);
+	if (arena->blocks == NULL) return;
 
-			buffer_size = sizeof(char) * tail;
-			bytes       = malloc(buffer_size);
+	if (arena->blocks->next == NULL && arena->reserved <= ARENA_MAX_KEPT)
+	{
+		arena->blocks->used = 0;
+		return;
+	}
 
-			for (i = 0; i < tail; i++) bytes[i] = RL_GET_CHAR(series, i);
+	size = arena->reserved <= ARENA_MAX_KEPT ? arena->reserved : ARENA_BLOCK_SIZE;
 
-			params[p].buffer = bytes;
-			params[p].size   = tail;
-			params[p].length = tail;
-			break;
+	for (block = arena->blocks; block; block = next)
+	{
+		next = block->next;
+		free(block);
 	}
 
-	switch (rebol_type)
+	arena->blocks   = NULL;
+	arena->reserved = 0;
+
+	if ((block = malloc(ARENA_HEADER + size)))
 	{
-		case RXT_INTEGER: 	c_type = SQL_C_LONG; 		sql_type = SQL_INTEGER; 	param = &(params[p].value.int64);	break;
-		case RXT_DECIMAL: 	c_type = SQL_C_DOUBLE; 		sql_type = SQL_DOUBLE; 		param = &(params[p].value.dec64);	break;
-		case RXT_LOGIC: 	c_type = SQL_C_BIT; 		sql_type = SQL_BIT; 		param = &(params[p].value.int64);	break;
-		case RXT_DATE: 		c_type = SQL_C_TYPE_DATE; 	sql_type = SQL_TYPE_DATE; 	param = params[p].buffer; 	        break;
-		case RXT_TIME: 		c_type = SQL_C_TYPE_TIME; 	sql_type = SQL_TYPE_TIME; 	param = params[p].buffer;			break;
-		case RXT_STRING:	c_type = SQL_C_WCHAR;		sql_type = SQL_VARCHAR;     param = chars;						break;
-		case RXT_BINARY:	c_type = SQL_C_BINARY;		sql_type = SQL_VARBINARY;   param = bytes;						break;
-		case RXT_NONE:
-		default:		 	c_type = SQL_C_DEFAULT;		sql_type = SQL_NULL_DATA;	params[p].length = SQL_NULL_DATA;   break;
-	}
+		block->next = NULL;
+		block->size = size;
+		block->used = 0;
 
-	// API call to SQLBindParameter
-	rc = SQLBindParameter(hstmt, p, SQL_PARAM_INPUT, c_type, sql_type, params[p].size, 0, param, buffer_size, &params[p].length);
-	return rc;
+		arena->blocks   = block;
+		arena->reserved = size;
+		arena->heap++;
+	}
 }
 
 
-/*##############################################################################
-##
-*/  SQLRETURN ODBC_GetCatalog(RXIFRM *frm, SQLHSTMT hstmt, enum GET_CATALOG which, REBSER *block)
+/*******************************************************************************
+**
+*/	void ODBC_FreeArena(ARENA *arena)
 /*
-##############################################################################*/
+*******************************************************************************/
 {
-	SQLWCHAR     pattern[4][255];
-	SQLSMALLINT  length[4];
-	int          arg;
-	RXIARG       value;
+	ARENA_BLOCK *block, *next;
 
-	for (arg = 0; arg < 4; arg++)
+	for (block = arena->blocks; block; block = next)
 	{
-		if (RL_GET_VALUE(block, arg + 1, &value) == RXT_STRING)
-		{
-			length[arg] = RL_SERIES(value.series, RXI_SER_TAIL);
-			ODBC_StringToSqlWChar(value.series, &pattern[arg][0]);
-		}
-		else length[arg] = 0;
+		next = block->next;
+		free(block);
 	}
 
-	switch (which)
-	{
-		case GET_CATALOG_TABLES:
-			return SQLTablesW(hstmt,
-				length[2] == 0 ? NULL : (SQLWCHAR *)&(pattern[2][0]), length[2], // catalog
-				length[1] == 0 ? NULL : (SQLWCHAR *)&(pattern[1][0]), length[1], // schema
-				length[0] == 0 ? NULL : (SQLWCHAR *)&(pattern[0][0]), length[0], // table
-				length[3] == 0 ? NULL : (SQLWCHAR *)&(pattern[3][0]), length[3]  // type
-			);
-			break;
-
-		case GET_CATALOG_COLUMNS:
-			return SQLColumnsW(hstmt,
-				length[3] == 0 ? NULL : (SQLWCHAR *)&(pattern[3][0]), length[3], // catalog
-				length[2] == 0 ? NULL : (SQLWCHAR *)&(pattern[2][0]), length[2], // schema
-				length[0] == 0 ? NULL : (SQLWCHAR *)&(pattern[0][0]), length[0], // table
-				length[1] == 0 ? NULL : (SQLWCHAR *)&(pattern[1][0]), length[1]  // column
-			);
-			break;
-
-		case GET_CATALOG_TYPES:
-			return SQLGetTypeInfoW(hstmt, SQL_ALL_TYPES);
-			break;
-	}
+	free(arena);
 }
 
 
 /*******************************************************************************
 **
-*/  SQLRETURN ODBC_DescribeResults(RXIFRM *frm, SQLHSTMT hstmt, int num_columns, COLUMN *columns, REBSER *titles)
+*/	SQLTEXT* ODBC_NormalizeSql(ARENA *arena, REBSER *source)
 /*
-**  Sets up the COLUMNS description, retrievs column titles and column descriptions
+**  Copies a statement string to SQLWCHARs, collapsing whitespace outside of
+**  quotes to single spaces (or newlines, to keep line comments intact) and
+**  trimming it, so that equivalent statement texts compare and hash equal.
+**
+**  Quotes are string literals and quoted identifiers in '..', "..", `..` or
+**  [..], with the closing quote doubled to escape it. Line comments (--) and
+**  (nested) block comments are kept as they are, so quotes within them
+**  don't count.
+**
+**  The text is allocated from ARENA, see ODBC_KeepSql for keeping it.
 **
 *******************************************************************************/
 {
-	SQLSMALLINT  col;
-	COLUMN      *column;
-	SQLRETURN    rc;
-	SQLWCHAR    *title;
+	SQLTEXT     *text;
+	int          i, tail, length = 0, white = 0, newline = 0, comment = 0;
+	SQLWCHAR     c, next, quote = 0;												// closing quote, or newline in line comments
+	u32          hash = 2166136261u;
+
+	tail = RL_SERIES(source, RXI_SER_TAIL);
+	text = ODBC_Alloc(arena, sizeof(SQLTEXT) + sizeof(SQLWCHAR) * tail);
+	if (text == NULL) return NULL;
+
+	for (i = 0; i < tail; i++)
+	{
+		c = RL_GET_CHAR(source, i);
+
+		if (!quote && !comment && (c == ' ' || c == '\t' || c == '\r' || c == '\n'))
+		{
+			white   = 1;
+			newline = newline || c == '\n';
+			continue;
+		}
+
+		if (white && length > 0) text->chars[length++] = newline ? '\n' : ' ';
+		white = newline = 0;
+
+		next = (i + 1 < tail) ? RL_GET_CHAR(source, i + 1) : 0;
+
+		if (comment)															// block comment
+		{
+			if ((c == '*' && next == '/') || (c == '/' && next == '*'))
+			{
+				comment += (c == '/') ? 1 : -1;
+				text->chars[length++] = c;
+				c = next; i++;
+			}
+		}
+		else if (quote)
+		{
+			if (c == quote && next == quote && quote != '\n')					// escaped quote
+			{
+				text->chars[length++] = c;
+				i++;
+			}
+			else if (c == quote) quote = 0;
+		}
+		else if (c == '\'' || c == '"' || c == '`') quote = c;
+		else if (c == '[') quote = ']';
+		else if (c == '-' && next == '-') quote = '\n';
+		else if (c == '/' && next == '*')
+		{
+			comment = 1;
+			text->chars[length++] = c;
+			c = next; i++;
+		}
+
+		text->chars[length++] = c;
+	}
+
+	for (i = 0; i < length; i++) hash = (hash ^ text->chars[i]) * 16777619u;	// FNV-1a
+
+	text->chars[length] = 0;
+	text->length = length;
+	text->hash   = hash;
+
+	return text;
+}
+
+
+/*******************************************************************************
+**
+*/	SQLTEXT* ODBC_KeepSql(SQLTEXT *text)
+/*
+**  Returns a heap copy of an arena allocated statement text, to be kept as a
+**  statement's prepared text.
+**
+*******************************************************************************/
+{
+	size_t       size = sizeof(SQLTEXT) + sizeof(SQLWCHAR) * text->length;
+	SQLTEXT     *copy = malloc(size);
+
+	if (copy) memcpy(copy, text, size);
+
+	return copy;
+}
+
+
+/*******************************************************************************
+**
+*/	PREPARED_CACHE* ODBC_GetCache(REBSER *statement)
+/*
+**  Returns the prepared statement cache of a statement's connection with its
+**  capacity updated from the connection's STATEMENT-CACHE option.
+**
+*******************************************************************************/
+{
+	RXIARG          value;
+	REBSER         *database;
+	PREPARED_CACHE *cache;
+
+	if (RL_GET_FIELD(statement, RL_MAP_WORD("database"), &value) != RXT_OBJECT) return NULL;
+	database = value.addr;
+
+	cache = (RL_GET_FIELD(database, RL_MAP_WORD("prepared"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (cache == NULL) return NULL;
+
+	cache->capacity = (RL_GET_FIELD(database, RL_MAP_WORD("statement-cache"), &value) == RXT_INTEGER && value.int64 > 0) ? (int)value.int64 : 0;
+
+	return cache;
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_ParkStatement(PREPARED_CACHE *cache, REBSER *statement)
+/*
+**  Moves the statement handle of a statement object along with its prepared
+**  statement text and bound columns into the cache, evicting the least
+**  recently used entry if the cache is full. Handles without prepared
+**  statements and evicted handles are kept as spare handles.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	SQLHSTMT     hstmt;
+	PREPARED    *entry, *entries;
+	SQLTEXT     *string;
+	int          e, lru;
+
+	hstmt  = (RL_GET_FIELD(statement, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	string = (RL_GET_FIELD(statement, RL_MAP_WORD("string"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+
+	if (hstmt == NULL) return;
+
+	SQLCloseCursor(hstmt);
+	ODBC_ResetParameters(statement, hstmt);										// the handle may come back to another statement
+
+	if (string && cache->capacity > 0)
+	{
+		if (cache->count >= cache->capacity)									// Evict least recently used entries
+		{
+			while (cache->count >= cache->capacity)
+			{
+				for (lru = 0, e = 1; e < cache->count; e++) if (cache->entries[e].used < cache->entries[lru].used) lru = e;
+
+				entry = &cache->entries[lru];
+				SQLFreeStmt(entry->hstmt, SQL_UNBIND);
+
+				if (cache->num_spare < MAX_SPARE_HANDLES) cache->spare[cache->num_spare++] = entry->hstmt;
+				else SQLFreeHandle(SQL_HANDLE_STMT, entry->hstmt);
+
+				ODBC_FreePlan(entry->columns, entry->values, entry->rowset);
+				free(entry->string);
+
+				cache->entries[lru] = cache->entries[--cache->count];
+				cache->evictions++;
+			}
+		}
+
+		if (cache->count >= cache->size)
+		{
+			entries = realloc(cache->entries, sizeof(PREPARED) * (cache->size + 8));
+			if (entries) { cache->entries = entries; cache->size += 8; }
+		}
+
+		if (cache->count < cache->size)
+		{
+			entry = &cache->entries[cache->count++];
+
+			entry->string  = string;
+			entry->hstmt   = hstmt;
+			entry->columns = (RL_GET_FIELD(statement, RL_MAP_WORD("columns"), &value) == RXT_HANDLE) ? value.addr : NULL;
+			entry->values  = (RL_GET_FIELD(statement, RL_MAP_WORD("values"),  &value) == RXT_HANDLE) ? value.addr : NULL;
+			entry->rowset  = (RL_GET_FIELD(statement, RL_MAP_WORD("rowset"),  &value) == RXT_HANDLE) ? value.addr : NULL;
+			entry->used    = ++cache->clock;
+
+			hstmt = NULL; string = NULL;
+			RL_SET_FIELD(statement, RL_MAP_WORD("columns"), value, RXT_NONE);	// plan now owned by cache entry
+			RL_SET_FIELD(statement, RL_MAP_WORD("values"),  value, RXT_NONE);
+			RL_SET_FIELD(statement, RL_MAP_WORD("rowset"),  value, RXT_NONE);
+		}
+	}
+
+	if (hstmt)																	// Nothing worth caching, keep the bare handle
+	{
+		SQLFreeStmt(hstmt, SQL_UNBIND);
+		if (cache->num_spare < MAX_SPARE_HANDLES) cache->spare[cache->num_spare++] = hstmt;
+		else SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+	}
+	if (string) free(string);
+
+	ODBC_FreeColumns(statement);
+
+	RL_SET_FIELD(statement, RL_MAP_WORD("statement"), value, RXT_NONE);
+	RL_SET_FIELD(statement, RL_MAP_WORD("string"),    value, RXT_NONE);
+}
+
+
+/*******************************************************************************
+**
+*/	SQLRETURN ODBC_RenewStatement(PREPARED_CACHE *cache, REBSER *statement, SQLHSTMT *hstmt)
+/*
+**  Parks the statement's current handle and gives the statement object a
+**  spare or newly allocated, unprepared one.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	SQLRETURN    rc;
+
+	ODBC_ParkStatement(cache, statement);
+
+	if (cache->num_spare > 0)
+	{
+		*hstmt = cache->spare[--cache->num_spare];
+		cache->reused++;
+	}
+	else
+	{
+		rc = SQLAllocHandle(SQL_HANDLE_STMT, cache->hdbc, hstmt);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return rc;
+	}
+
+	value.addr = *hstmt;
+	RL_SET_FIELD(statement, RL_MAP_WORD("statement"), value, RXT_HANDLE);
+
+	return SQL_SUCCESS;
+}
+
+
+/*******************************************************************************
+**
+*/	SQLRETURN ODBC_PrepareCached(PREPARED_CACHE *cache, REBSER *statement, SQLTEXT *string, SQLHSTMT *hstmt, int *bind)
+/*
+**  Makes STRING the prepared statement of a statement object. A cached
+**  handle already prepared with the same text is taken over along with its
+**  bound columns, otherwise the statement's handle is renewed and prepared.
+**  On success, STRING is owned by the statement object (or freed).
+**
+**  Returns:
+**      SQLPrepare's return code, *HSTMT set to the statement's handle and
+**      *BIND set if the result set columns have to be bound.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	SQLRETURN    rc;
+	PREPARED     entry;
+	LONGLONG     ticks;
+	int          e, prepared;
+
+	for (e = 0; e < cache->count; e++)
+	{
+		if (cache->entries[e].string->hash   == string->hash   &&
+			cache->entries[e].string->length == string->length &&
+			cache->entries[e].string->cursor == string->cursor &&
+			!memcmp(cache->entries[e].string->chars, string->chars, sizeof(SQLWCHAR) * string->length)
+		) break;
+	}
+
+	prepared = RL_GET_FIELD(statement, RL_MAP_WORD("string"), &value) == RXT_HANDLE;
+
+	if (e < cache->count)														// Hit, take over cached handle and plan
+	{
+		cache->hits++;
+
+		entry = cache->entries[e];
+		cache->entries[e] = cache->entries[--cache->count];
+
+		if (prepared) ODBC_ParkStatement(cache, statement);
+		else
+		{
+			ODBC_FreeColumns(statement);
+			ODBC_ResetParameters(statement, *hstmt);
+			SQLFreeStmt(*hstmt, SQL_UNBIND);
+			if (cache->num_spare < MAX_SPARE_HANDLES) cache->spare[cache->num_spare++] = *hstmt;
+			else SQLFreeHandle(SQL_HANDLE_STMT, *hstmt);
+		}
+
+		*hstmt = entry.hstmt;
+		*bind  = entry.columns == NULL;
+
+		value.addr = entry.hstmt;   RL_SET_FIELD(statement, RL_MAP_WORD("statement"), value, RXT_HANDLE);
+		value.addr = entry.string;  RL_SET_FIELD(statement, RL_MAP_WORD("string"),    value, RXT_HANDLE);
+		if (entry.columns)
+		{
+			value.addr = entry.columns; RL_SET_FIELD(statement, RL_MAP_WORD("columns"), value, RXT_HANDLE);
+			value.addr = entry.values;  RL_SET_FIELD(statement, RL_MAP_WORD("values"),  value, RXT_HANDLE);
+			value.addr = entry.rowset;  RL_SET_FIELD(statement, RL_MAP_WORD("rowset"),  value, RXT_HANDLE);
+		}
+
+		free(string);
+		return SQL_SUCCESS;
+	}
+
+	cache->misses++;
+
+	if (prepared)																// Keep the current prepared statement cached
+	{
+		rc = ODBC_RenewStatement(cache, statement, hstmt);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { free(string); return rc; }
+	}
+
+	rc = SQLSetStmtAttr(*hstmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)string->cursor, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { free(string); return rc; }
+
+	ticks = ODBC_TRACE_TICKS();
+
+	rc = SQLPrepare(*hstmt, string->chars, string->length);
+	ODBC_TRACE("SQLPrepare", *hstmt, ticks, 0, rc);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { free(string); return rc; }
+
+	value.addr = string; RL_SET_FIELD(statement, RL_MAP_WORD("string"), value, RXT_HANDLE);
+	*bind = TRUE;
+
+	return rc;
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_FreeCache(PREPARED_CACHE *cache)
+/*
+*******************************************************************************/
+{
+	int          e;
+
+	for (e = 0; e < cache->count; e++)
+	{
+		SQLFreeHandle(SQL_HANDLE_STMT, cache->entries[e].hstmt);
+		ODBC_FreePlan(cache->entries[e].columns, cache->entries[e].values, cache->entries[e].rowset);
+		free(cache->entries[e].string);
+	}
+
+	for (e = 0; e < cache->num_spare; e++) SQLFreeHandle(SQL_HANDLE_STMT, cache->spare[e]);
+
+	if (cache->entries) free(cache->entries);
+	free(cache);
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Query(RXIFRM *frm)
+/*
+**  Returns:
+**      Block of set-words and values with the statistics of a connection's
+**      prepared statement cache, or of a statement's arena.
+**
+*******************************************************************************/
+{
+	REBSER         *database, *block;
+	RXIARG          value;
+	PREPARED_CACHE *cache;
+	ARENA          *arena;
+	int             i = 0;
+
+	database = RXA_OBJECT(frm, 1);
+
+	if (RL_GET_FIELD(database, RL_MAP_WORD("arena"), &value) == RXT_HANDLE)		// statement object
+	{
+		arena = value.addr;
+		block = RL_MAKE_BLOCK(10);
+
+		value.int32a = RL_MAP_WORD("executions");  RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+		value.int64  = arena->resets;              RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+		value.int32a = RL_MAP_WORD("allocations"); RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+		value.int64  = arena->allocations;         RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+		value.int32a = RL_MAP_WORD("heap");        RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+		value.int64  = arena->heap;                RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+		value.int32a = RL_MAP_WORD("reserved");    RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+		value.int64  = arena->reserved;            RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+		value.int32a = RL_MAP_WORD("peak");        RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+		value.int64  = arena->peak;                RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+
+		RXA_SERIES(frm, 1) = block;
+		RXA_INDEX (frm, 1) = 0;
+		RXA_TYPE  (frm, 1) = RXT_BLOCK;
+
+		return RXR_VALUE;
+	}
+
+	cache = (RL_GET_FIELD(database, RL_MAP_WORD("prepared"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (cache == NULL) return MAKE_ERROR(L"Invalid connection argument!");
+
+	block = RL_MAKE_BLOCK(12);
+
+	value.int32a = RL_MAP_WORD("cached");    RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = cache->count;             RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("hits");      RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = cache->hits;              RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("misses");    RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = cache->misses;            RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("evictions"); RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = cache->evictions;         RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("spare");     RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = cache->num_spare;         RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("reused");    RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = cache->reused;            RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+
+	RXA_SERIES(frm, 1) = block;
+	RXA_INDEX (frm, 1) = 0;
+	RXA_TYPE  (frm, 1) = RXT_BLOCK;
+
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Stats(RXIFRM *frm)
+/*
+**  Returns:
+**      Block of set-words and values with the performance counters of a
+**      statement or connection: counts, times spent (as TIME!), rows and
+**      bytes fetched, prepared statement reuse, bytes allocated per execution
+**      and a block of executions taking less than 1, 2, 4 .. 16384 ms and
+**      longer.
+**
+*******************************************************************************/
+{
+	REBSER      *block, *latency;
+	RXIARG       value;
+	STATS       *stats;
+	int          i = 0, b;
+
+	stats = ODBC_GetStats(RXA_OBJECT(frm, 1));
+	if (stats == NULL) return MAKE_ERROR(L"Invalid statement or connection!");
+
+	block   = RL_MAKE_BLOCK(26);
+	latency = RL_MAKE_BLOCK(LATENCY_BUCKETS);
+	if (ODBC_Frequency == 0) ODBC_Ticks();
+
+	value.int32a = RL_MAP_WORD("prepares");      RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->prepares;              RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("prepare-time");  RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = ODBC_TicksToNanoseconds(stats->prepare_time); RL_SET_VALUE(block, i++, value, RXT_TIME);
+	value.int32a = RL_MAP_WORD("executions");    RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->executions;            RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("execute-time");  RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = ODBC_TicksToNanoseconds(stats->execute_time); RL_SET_VALUE(block, i++, value, RXT_TIME);
+	value.int32a = RL_MAP_WORD("fetches");       RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->fetches;               RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("fetch-time");    RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = ODBC_TicksToNanoseconds(stats->fetch_time);   RL_SET_VALUE(block, i++, value, RXT_TIME);
+	value.int32a = RL_MAP_WORD("convert-time");  RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = ODBC_TicksToNanoseconds(stats->convert_time); RL_SET_VALUE(block, i++, value, RXT_TIME);
+	value.int32a = RL_MAP_WORD("rows");          RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->rows;                  RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("bytes");         RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->bytes;                 RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("hits");          RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->hits;                  RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("binds");         RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->binds;                 RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+	value.int32a = RL_MAP_WORD("allocated");     RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.int64  = stats->allocated;             RL_SET_VALUE(block, i++, value, RXT_INTEGER);
+
+	for (b = 0; b < LATENCY_BUCKETS; b++)
+	{
+		value.int64 = stats->latency[b];
+		RL_SET_VALUE(latency, b, value, RXT_INTEGER);
+	}
+
+	value.int32a = RL_MAP_WORD("latency"); RL_SET_VALUE(block, i++, value, RXT_SET_WORD);
+	value.series = latency;
+	value.index  = 0;                      RL_SET_VALUE(block, i++, value, RXT_BLOCK);
+
+	RXA_SERIES(frm, 1) = block;
+	RXA_INDEX (frm, 1) = 0;
+	RXA_TYPE  (frm, 1) = RXT_BLOCK;
+
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	STATS *ODBC_GetStats(REBSER *object)
+/*
+*******************************************************************************/
+{
+	RXIARG       value;
+
+	return (RL_GET_FIELD(object, RL_MAP_WORD("stats"), &value) == RXT_HANDLE) ? value.addr : NULL;
+}
+
+
+/*******************************************************************************
+**
+*/	LONGLONG ODBC_Ticks(void)
+/*
+*******************************************************************************/
+{
+	LARGE_INTEGER counter;
+
+	if (ODBC_Frequency == 0)
+	{
+		QueryPerformanceFrequency(&counter);
+		ODBC_Frequency = counter.QuadPart;
+	}
+
+	QueryPerformanceCounter(&counter);
+	return counter.QuadPart;
+}
+
+
+/*******************************************************************************
+**
+*/	i64 ODBC_TicksToNanoseconds(LONGLONG ticks)
+/*
+*******************************************************************************/
+{
+	return (i64)((double)ticks * 1e9 / (ODBC_Frequency ? ODBC_Frequency : 1));
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_CountExecution(STATS *stats, LONGLONG ticks)
+/*
+**  Counts an execution taking TICKS in the statement's counters and latency
+**  histogram, as well as in its connection's.
+**
+*******************************************************************************/
+{
+	LONGLONG     ms;
+	int          b;
+
+	ms = ticks * 1000 / (ODBC_Frequency ? ODBC_Frequency : 1);
+	for (b = 0; b < LATENCY_BUCKETS - 1 && ms >= ((LONGLONG)1 << b); b++);
+
+	ODBC_COUNT(stats, executions, 1);
+	ODBC_COUNT(stats, execute_time, ticks);
+	ODBC_COUNT(stats, latency[b], 1);
+}
+
+//a: b: c: 0 dt [loop 512 [cache:      open odbc://cachesamples a: a + 1                               close cache      b: b + 1]]
+//a: b: c: 0 dt [loop 512 [cache:      open odbc://cachesamples a: a + 1 db: first cache      b: b + 1 close cache      c: c + 1]]
+//dbs: [] a: 0 dt [cache: open odbc://cachesamples loop 512 [append dbs first cache a: a + 1] close cache]
+
+//a: b: c: 0 dt [loop 512 [postgresql: open odbc://pgsamples    a: a + 1                               close postgresql b: b + 1]]
+//a: b: c: 0 dt [loop 512 [postgresql: open odbc://pgsamples    a: a + 1 db: first postgresql b: b + 1 close postgresql c: c + 1]]
+
+
+/*******************************************************************************
+**
+*/	void ODBC_TraceEvent(const char *name, void *id, LONGLONG start, i64 rows, SQLRETURN rc)
+/*
+**  Records a call from START until now in the trace ring buffer, overwriting
+**  the oldest event once it's full. Slots are claimed with an interlocked
+**  increment, so worker threads record without locking. Use the ODBC_TRACE
+**  macro, which costs a single test while not tracing.
+**
+*******************************************************************************/
+{
+	TRACE_EVENT *event;
+	ULONG        number;
+
+	number = (ULONG)InterlockedIncrement(&ODBC_TraceNext) - 1;
+	event  = &ODBC_Trace[number & (ODBC_TraceSize - 1)];
+
+	event->sequence = 0;
+	event->name     = name;
+	event->id       = id;
+	event->start    = start;
+	event->end      = ODBC_Ticks();
+	event->rows     = rows;
+	event->rc       = rc;
+	event->thread   = GetCurrentThreadId();
+	MemoryBarrier();
+	event->sequence = number + 1;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_TraceStart(RXIFRM *frm)
+/*
+**  Starts tracing ODBC calls into a ring buffer of SIZE events (rounded up to
+**  a power of two), discarding events recorded before, or stops tracing if
+**  SIZE is 0. The ring buffer is allocated with the first start and keeps its
+**  size, as worker threads may still be recording into it.
+**
+**  Returns the ring buffer's size in events.
+**
+*******************************************************************************/
+{
+	i64          size;
+	ULONG        slots;
+
+	size = RXA_INT64(frm, 1);
+
+	if (size <= 0)
+	{
+		ODBC_Tracing = FALSE;
+	}
+	else
+	{
+		if (ODBC_Trace == NULL)
+		{
+			if (size > (1 << 24)) size = 1 << 24;
+			for (slots = 1; slots < (ULONG)size; slots <<= 1);
+
+			ODBC_Trace = calloc(slots, sizeof(TRACE_EVENT));
+			if (ODBC_Trace == NULL) return MAKE_ERROR(L"Couldn't allocate trace buffer!");
+			ODBC_TraceSize = slots;
+		}
+
+		if (ODBC_Frequency == 0) ODBC_Ticks();
+		InterlockedExchange(&ODBC_TraceNext, 0);
+		ODBC_Tracing = TRUE;
+	}
+
+	RXA_INT64(frm, 1) = ODBC_TraceSize;
+	RXA_TYPE (frm, 1) = RXT_INTEGER;
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_TraceDump(RXIFRM *frm)
+/*
+**  Writes the events of the trace ring buffer to a file in Chrome's trace
+**  event format (JSON, "X" complete events with microsecond timestamps),
+**  to be loaded into chrome://tracing or Perfetto. Events still being
+**  recorded are left out.
+**
+**  Returns the number of events written.
+**
+*******************************************************************************/
+{
+	EXPORT       export;
+	TRACE_EVENT  event;
+	REBSER      *string;
+	SQLWCHAR    *path;
+	ULONG        next, count, number, k;
+	DWORD        process;
+	char        *out;
+	i64          written = 0;
+	int          length;
+
+	string = RXA_SERIES(frm, 1);												// Local file name
+	length = RL_SERIES(string, RXI_SER_TAIL);
+
+	memset(&export, 0, sizeof(export));
+	path          = malloc(sizeof(SQLWCHAR) * (length + 1));
+	export.buffer = malloc(EXPORT_BUFFER_SIZE);
+	if (path == NULL || export.buffer == NULL)
+	{
+		if (path)          free(path);
+		if (export.buffer) free(export.buffer);
+		return MAKE_ERROR(L"Couldn't allocate trace buffers!");
+	}
+
+	ODBC_StringToSqlWChar(string, path);
+	path[length] = 0;
+
+	export.file = CreateFileW(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	free(path);
+	if (export.file == INVALID_HANDLE_VALUE)
+	{
+		free(export.buffer);
+		return MAKE_ERROR(L"Couldn't create trace file!");
+	}
+
+	process = GetCurrentProcessId();
+	next    = (ULONG)ODBC_TraceNext;
+	count   = (next < ODBC_TraceSize) ? next : ODBC_TraceSize;
+
+	out = ODBC_ExportReserve(&export, 32);
+	export.used += sprintf(out, "{\"traceEvents\":[");
+
+	for (k = 0; k < count; k++)
+	{
+		number = next - count + k;
+		event  = ODBC_Trace[number & (ODBC_TraceSize - 1)];
+		MemoryBarrier();
+		if (event.sequence != number + 1 || ODBC_Trace[number & (ODBC_TraceSize - 1)].sequence != number + 1) continue; // being (over)written
+
+		out = ODBC_ExportReserve(&export, 256);
+		export.used += sprintf(out,
+			"%s\n{\"name\":\"%s\",\"cat\":\"odbc\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%lu,\"tid\":%lu,"
+			"\"args\":{\"handle\":\"0x%llx\",\"rows\":%lld,\"rc\":%d}}",
+			written ? "," : "", event.name,
+			ODBC_TicksToNanoseconds(event.start) / 1000.0, ODBC_TicksToNanoseconds(event.end - event.start) / 1000.0,
+			(unsigned long)process, (unsigned long)event.thread,
+			(unsigned long long)(ULONG_PTR)event.id, (long long)event.rows, (int)event.rc
+		);
+		written++;
+	}
+
+	out = ODBC_ExportReserve(&export, 32);
+	export.used += sprintf(out, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+	ODBC_ExportFlush(&export);
+	CloseHandle(export.file);
+	free(export.buffer);
+
+	if (export.error) return MAKE_ERROR(L"Couldn't write trace file!");
+
+	RXA_INT64(frm, 1) = written;
+	RXA_TYPE (frm, 1) = RXT_INTEGER;
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Update(RXIFRM *frm)
+/*
+*******************************************************************************/
+{
+	SQLHDBC      hdbc;
+	SQLRETURN    rc;
+	RXIARG       value;
+	REBSER      *database;
+	i64          access, commit;
+	int          type;
+
+	database  = RXA_OBJECT(frm, 1);
+	access    = RXA_LOGIC (frm, 2);
+	commit    = RXA_LOGIC (frm, 3);
+
+	type = RL_GET_FIELD(database, RL_MAP_WORD("connection"), &value);			// Get connection handle
+	if (type != RXT_HANDLE) return MAKE_ERROR(L"Invalid connection argument!");
+
+	hdbc = value.addr;
+
+	rc = SQLSetConnectAttr(hdbc, SQL_ATTR_ACCESS_MODE, (SQLPOINTER *)(access ? SQL_MODE_READ_WRITE : SQL_MODE_READ_ONLY), SQL_IS_UINTEGER);							// Allocate the statement handle
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+
+	rc = SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT,  (SQLPOINTER *)(commit ? SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF), SQL_IS_UINTEGER);							// Allocate the statement handle
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_EndTran(RXIFRM *frm)
+/*
+**  Commits the current transaction of a connection, or rolls it back if
+**  COMMIT is FALSE.
+**
+*******************************************************************************/
+{
+	SQLHDBC      hdbc;
+	SQLRETURN    rc;
+	RXIARG       value;
+	REBSER      *database;
+
+	database = RXA_OBJECT(frm, 1);
+
+	if (RL_GET_FIELD(database, RL_MAP_WORD("connection"), &value) != RXT_HANDLE) return MAKE_ERROR(L"Invalid connection argument!");
+	hdbc = value.addr;
+
+	rc = SQLEndTran(SQL_HANDLE_DBC, hdbc, RXA_LOGIC(frm, 2) ? SQL_COMMIT : SQL_ROLLBACK);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Autocommit(RXIFRM *frm)
+/*
+**  Turns autocommit of a connection on or off, leaving the access mode
+**  alone. Turning it on commits the current transaction.
+**
+*******************************************************************************/
+{
+	SQLHDBC      hdbc;
+	SQLRETURN    rc;
+	RXIARG       value;
+	REBSER      *database;
+
+	database = RXA_OBJECT(frm, 1);
+
+	if (RL_GET_FIELD(database, RL_MAP_WORD("connection"), &value) != RXT_HANDLE) return MAKE_ERROR(L"Invalid connection argument!");
+	hdbc = value.addr;
+
+	rc = SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)(RXA_LOGIC(frm, 2) ? SQL_AUTOCOMMIT_ON : SQL_AUTOCOMMIT_OFF), SQL_IS_UINTEGER);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Reset(RXIFRM *frm)
+/*
+**  Resets a connection to the state of a newly opened one before it is
+**  returned to the connection pool: rolls back uncommitted work and turns
+**  autocommit and read-write access on.
+**
+*******************************************************************************/
+{
+	SQLHDBC      hdbc;
+	SQLRETURN    rc;
+	RXIARG       value;
+	REBSER      *database;
+
+	database = RXA_OBJECT(frm, 1);
+
+	if (RL_GET_FIELD(database, RL_MAP_WORD("connection"), &value) != RXT_HANDLE) return MAKE_ERROR(L"Invalid connection argument!");
+	hdbc = value.addr;
+
+	rc = SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_ROLLBACK);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+
+	rc = SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT,  (SQLPOINTER)SQL_AUTOCOMMIT_ON,  SQL_IS_UINTEGER);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+
+	rc = SQLSetConnectAttr(hdbc, SQL_ATTR_ACCESS_MODE, (SQLPOINTER)SQL_MODE_READ_WRITE, SQL_IS_UINTEGER);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Ping(RXIFRM *frm)
+/*
+**  Returns FALSE if the driver knows a connection to be dead
+**  (SQL_ATTR_CONNECTION_DEAD), TRUE otherwise, also with drivers not
+**  supporting the attribute.
+**
+*******************************************************************************/
+{
+	SQLHDBC      hdbc;
+	SQLRETURN    rc;
+	SQLUINTEGER  dead = 0;
+	RXIARG       value;
+	REBSER      *database;
+
+	database = RXA_OBJECT(frm, 1);
+
+	if (RL_GET_FIELD(database, RL_MAP_WORD("connection"), &value) != RXT_HANDLE) return RXR_FALSE;
+	hdbc = value.addr;
+
+	rc = SQLGetConnectAttr(hdbc, SQL_ATTR_CONNECTION_DEAD, &dead, SQL_IS_UINTEGER, NULL);
+
+	return (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO) && dead == SQL_CD_TRUE ? RXR_FALSE : RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_BindParameters(RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, STATS *stats, REBSER *arguments, int num_params)
+/*
+**  Binds the values following the SQL string in ARGUMENTS as the statement's
+**  parameters, to buffers kept with the statement object across executions.
+**
+**  Re-executions with the same number of parameters only write the values
+**  into the bound buffers. A parameter is bound again only if its type
+**  changes or its value doesn't fit the buffer, which then grows to at least
+**  twice its size. Binds are counted in STATS.
+**
+**  Binary values and strings of SQLWCHAR width aren't copied, the series
+**  data is bound up to the series' capacity instead (as it's only read when
+**  executing, right after binding). These are bound again only if the data
+**  moved or grew beyond the capacity bound, e.g. with another series.
+**
+**  Returns 0, or the command's result with the error set in FRM.
+**
+*******************************************************************************/
+{
+	BINDINGS    *bindings;
+	PARAMETER   *param;
+	RXIARG       value;
+	SQLSMALLINT  c_type, sql_type;
+	SQLULEN      column_size;
+	SQLLEN       size, bound;
+	SQLRETURN    rc;
+	void        *buffer, *data;
+	int          p, type;
+
+	bindings = (RL_GET_FIELD(object, RL_MAP_WORD("bindings"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (bindings == NULL)
+	{
+		bindings = calloc(1, sizeof(BINDINGS));
+		if (bindings == NULL) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
+
+		value.addr = bindings; RL_SET_FIELD(object, RL_MAP_WORD("bindings"), value, RXT_HANDLE);
+	}
+
+	if (bindings->hstmt != hstmt || bindings->count != num_params)				// Bound to another handle or number of markers
+	{
+		SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+
+		if (bindings->capacity < num_params)
+		{
+			param = realloc(bindings->params, sizeof(PARAMETER) * (num_params + 1));
+			if (param == NULL) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
+
+			p = bindings->params ? bindings->capacity + 1 : 0;
+			memset(param + p, 0, sizeof(PARAMETER) * (num_params + 1 - p));
+
+			bindings->params   = param;
+			bindings->capacity = num_params;
+		}
+		for (p = 1; p <= num_params; p++) bindings->params[p].rebol_type = RXT_END;	// none bound
+
+		bindings->hstmt = hstmt;
+		bindings->count = num_params;
+	}
+
+	for (p = 1; p <= num_params; p++)
+	{
+		param = &bindings->params[p];
+		type  = RL_GET_VALUE(arguments, p, &value);
+
+		switch (type)
+		{
+			case RXT_INTEGER: size = sizeof(SQLBIGINT);   break;
+			case RXT_DECIMAL: size = sizeof(double);      break;
+			case RXT_LOGIC:   size = sizeof(SQLCHAR);     break;
+			case RXT_DATE:    size = sizeof(DATE_STRUCT); break;
+			case RXT_TIME:    size = sizeof(TIME_STRUCT); break;
+			case RXT_STRING:  size = sizeof(SQLWCHAR) * RL_SERIES(value.series, RXI_SER_TAIL); break;
+			case RXT_BINARY:  size = RL_SERIES(value.series, RXI_SER_TAIL); break;
+			default:          size = 0;
+		}
+
+		if (type == RXT_BINARY || (type == RXT_STRING && RL_SERIES(value.series, RXI_SER_WIDE) == sizeof(SQLWCHAR)))
+		{
+			data  = (void *)RL_SERIES(value.series, RXI_SER_DATA);				// bind series data, no copy
+			bound = RL_SERIES(value.series, RXI_SER_SIZE) * RL_SERIES(value.series, RXI_SER_WIDE);
+		}
+		else
+		{
+			data  = NULL;
+			bound = 0;
+		}
+
+		if (type != param->rebol_type || (data ? data != param->data || size > param->bound : param->data != param->buffer || size > param->size))
+		{
+			if (data == NULL && size > param->size)								// grow the copy buffer
+			{
+				if (size < 2 * param->size) size = 2 * param->size;
+				size = (size + 63) & ~(SQLLEN)63;
+
+				buffer = realloc(param->buffer, size);
+				if (buffer == NULL) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
+
+				param->buffer = buffer;
+				param->size   = size;
+			}
+
+			if (data == NULL)
+			{
+				data  = param->buffer;
+				bound = param->size;
+			}
+
+			param->rebol_type = type;
+			param->lengths    = &param->length;
+
+			switch (type)
+			{
+				case RXT_INTEGER: 	c_type = SQL_C_SBIGINT; 	sql_type = SQL_BIGINT; 		column_size = 0;						break;
+				case RXT_DECIMAL: 	c_type = SQL_C_DOUBLE; 		sql_type = SQL_DOUBLE; 		column_size = 0;						break;
+				case RXT_LOGIC: 	c_type = SQL_C_BIT; 		sql_type = SQL_BIT; 		column_size = 0;						break;
+				case RXT_DATE: 		c_type = SQL_C_TYPE_DATE; 	sql_type = SQL_TYPE_DATE; 	column_size = sizeof(DATE_STRUCT);		break;
+				case RXT_TIME: 		c_type = SQL_C_TYPE_TIME; 	sql_type = SQL_TYPE_TIME; 	column_size = sizeof(TIME_STRUCT);		break;
+				case RXT_STRING:	c_type = SQL_C_WCHAR;		sql_type = SQL_VARCHAR;     column_size = bound / sizeof(SQLWCHAR); break;
+				case RXT_BINARY:	c_type = SQL_C_BINARY;		sql_type = SQL_VARBINARY;   column_size = bound;					break;
+				case RXT_NONE:
+				default:		 	c_type = SQL_C_DEFAULT;		sql_type = SQL_NULL_DATA;	column_size = 0;						break;
+			}
+
+			rc = SQLBindParameter(hstmt, p, SQL_PARAM_INPUT, c_type, sql_type, column_size, 0, data, bound, param->lengths);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
+			{
+				param->rebol_type = RXT_END;
+				return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+			}
+
+			param->data  = data;
+			param->bound = bound;
+
+			ODBC_COUNT(stats, binds, 1);
+		}
+
+		if (param->data != param->buffer) param->length = size;					// bound to the series data
+		else ODBC_SetParameterValue(param, 0, &value, type);
+	}
+
+	return 0;
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_ResetParameters(REBSER *statement, SQLHSTMT hstmt)
+/*
+**  Unbinds the parameters of HSTMT, the statement's bindings are bound again
+**  on its next execution.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	BINDINGS    *bindings;
+
+	SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+
+	bindings = (RL_GET_FIELD(statement, RL_MAP_WORD("bindings"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (bindings && bindings->hstmt == hstmt) bindings->hstmt = NULL;
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_FreeBindings(REBSER *statement)
+/*
+**  Unbinds the parameters of the statement object and frees their buffers.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	BINDINGS    *bindings;
+	int          p;
+
+	bindings = (RL_GET_FIELD(statement, RL_MAP_WORD("bindings"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (bindings == NULL) return;
+
+	if (bindings->hstmt) SQLFreeStmt(bindings->hstmt, SQL_RESET_PARAMS);
+
+	for (p = 1; p <= bindings->capacity; p++) if (bindings->params[p].buffer) free(bindings->params[p].buffer);
+	if (bindings->params) free(bindings->params);
+	free(bindings);
+
+	RL_SET_FIELD(statement, RL_MAP_WORD("bindings"), value, RXT_NONE);
+}
+
+
+/*******************************************************************************
+**
+*/	SQLRETURN ODBC_BindParameterArray(RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, PARAMETER *param, int p, SQLULEN rows)
+/*
+**  Allocates (from ARENA) and binds a column-wise array of ROWS parameter values. The
+**  element size PARAM->SIZE and PARAM->REBOL_TYPE have to be set up by the
+**  caller, values are filled in with ODBC_SetParameterValue.
+**
+*******************************************************************************/
+{
+	SQLSMALLINT  c_type, sql_type;
+	SQLULEN      column_size;
+
+	param->buffer  = ODBC_Alloc(arena, param->size * rows);
+	param->lengths = ODBC_Alloc(arena, sizeof(SQLLEN) * rows);
+	if (param->buffer == NULL || param->lengths == NULL) return MAKE_ERROR(L"Couldn't allocate parameter array!");
+
+	column_size = param->size;
+
+	switch (param->rebol_type)
+	{
+		case RXT_INTEGER: 	c_type = SQL_C_SBIGINT; 	sql_type = SQL_BIGINT; 		break;
+		case RXT_DECIMAL: 	c_type = SQL_C_DOUBLE; 		sql_type = SQL_DOUBLE; 		break;
+		case RXT_LOGIC: 	c_type = SQL_C_BIT; 		sql_type = SQL_BIT; 		break;
+		case RXT_DATE: 		c_type = SQL_C_TYPE_DATE; 	sql_type = SQL_TYPE_DATE; 	break;
+		case RXT_TIME: 		c_type = SQL_C_TYPE_TIME; 	sql_type = SQL_TYPE_TIME;	break;
+		case RXT_BINARY:	c_type = SQL_C_BINARY;		sql_type = SQL_VARBINARY;	break;
+		case RXT_STRING:
+		case RXT_NONE:
+		default:			c_type = SQL_C_WCHAR;		sql_type = SQL_VARCHAR;		column_size = param->size / sizeof(SQLWCHAR); break;
+	}
+
+	return SQLBindParameter(hstmt, p, SQL_PARAM_INPUT, c_type, sql_type, column_size, 0, param->buffer, param->size, param->lengths);
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_SetParameterValue(PARAMETER *param, SQLULEN row, RXIARG *value, int type)
+/*
+**  Stores VALUE into element ROW of a parameter array bound with
+**  ODBC_BindParameterArray. NONE values and values of other types than the
+**  array's are stored as NULL.
+**
+*******************************************************************************/
+{
+	char        *buffer = (char *)param->buffer + row * param->size;
+	TIME_STRUCT *time;
+	DATE_STRUCT	*date;
+	int          tail;
+
+	if (type != param->rebol_type)
+	{
+		param->lengths[row] = SQL_NULL_DATA;
+		return;
+	}
+
+	switch (type)
+	{
+		case RXT_INTEGER:
+			*(SQLBIGINT *)buffer  = (SQLBIGINT)value->int64;
+			param->lengths[row]   = sizeof(SQLBIGINT);
+			break;
+
+		case RXT_DECIMAL:
+			*(double *)buffer   = value->dec64;
+			param->lengths[row] = sizeof(double);
+			break;
+
+		case RXT_LOGIC:
+			*(SQLCHAR *)buffer  = value->int32a ? 1 : 0;
+			param->lengths[row] = sizeof(SQLCHAR);
+			break;
+
+		case RXT_TIME:
+			time = (TIME_STRUCT *)buffer;
+			time->hour   = (value->int64 / 3.6e12);
+			time->minute = (value->int64 - (time->hour * 3.6e12)) / 6e10;
+			time->second = (value->int64 - (time->hour * 3.6e12) - (time->minute * 60e9)) / 1000e6;
+			param->lengths[row] = sizeof(TIME_STRUCT);
+			break;
+
+		case RXT_DATE:
+			date = (DATE_STRUCT *)buffer;
+			date->year   = (value->int32a & 1073676288) >> 16;
+			date->month  = (value->int32a & 	 61440) >> 12;
+			date->day    = (value->int32a &       3968) >>  7;
+			param->lengths[row] = sizeof(DATE_STRUCT);
+			break;
+
+		case RXT_STRING:
+			param->lengths[row] = sizeof(SQLWCHAR) * ODBC_StringToSqlWChar(value->series, (SQLWCHAR *)buffer);
+			break;
+
+		case RXT_BINARY:
+			tail = RL_SERIES(value->series, RXI_SER_TAIL);
+			memcpy(buffer, (void *)RL_SERIES(value->series, RXI_SER_DATA), tail);
+			param->lengths[row] = tail;
+			break;
+
+		default:
+			param->lengths[row] = SQL_NULL_DATA;
+	}
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_ExecuteBulk(RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, REBSER *object, REBSER *rows, u32 index)
+/*
+**  Executes a prepared statement once per batch of rows from the ROWS block
+**  of (parameter) blocks, binding whole columns of values as parameter
+**  arrays (SQL_ATTR_PARAMSET_SIZE). The batch size is taken from the
+**  statement's BATCH-SIZE option. Parameter arrays are allocated from the
+**  statement ARENA.
+**
+**  Returns:
+**      Block of the total number of rows affected as reported by the driver
+**      and a block with one status word per row (SUCCESS, INFO, ERROR,
+**      UNUSED or UNKNOWN).
+**
+*******************************************************************************/
+{
+	PARAMETER    *params;
+	SQLUSMALLINT *status;
+	SQLULEN       batch_size, processed, first, count, r;
+	SQLLEN        affected, total = 0;
+	SQLRETURN     rc;
+	RXIARG        value, row, item;
+	REBSER       *result, *statuses;
+	LONGLONG      ticks;
+	u32           num_rows, num_params, p, tail;
+	int           type, error = 0;
+	u32           w_success, w_info, w_error, w_unused, w_unknown;
+
+	batch_size = (RL_GET_FIELD(object, RL_MAP_WORD("batch-size"), &value) == RXT_INTEGER && value.int64 > 0) ? (SQLULEN)value.int64 : 1;
+
+	num_rows = RL_SERIES(rows, RXI_SER_TAIL) - index;
+	if (num_rows < 1 || RL_GET_VALUE(rows, index, &row) != RXT_BLOCK) return MAKE_ERROR(L"Invalid parameter rows!");
+
+	num_params = RL_SERIES(row.series, RXI_SER_TAIL) - row.index;
+	if (num_params < 1) return MAKE_ERROR(L"Invalid parameter rows!");
+
+	if (batch_size > num_rows) batch_size = num_rows;
+
+	params = ODBC_Alloc(arena, sizeof(PARAMETER) * (num_params + 1));
+	status = ODBC_Alloc(arena, sizeof(SQLUSMALLINT) * batch_size);
+	if (params == NULL || status == NULL) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
+
+	memset(params, 0, sizeof(PARAMETER) * (num_params + 1));
+
+	// Determine parameter type and element size per column
+	//
+	for (p = 1; p <= num_params; p++) params[p].rebol_type = RXT_NONE;
+
+	for (r = 0; r < num_rows; r++)
+	{
+		if (RL_GET_VALUE(rows, index + r, &row) != RXT_BLOCK || RL_SERIES(row.series, RXI_SER_TAIL) - row.index != num_params)
+			return MAKE_ERROR(L"Parameter rows differ in length!");
+
+		for (p = 1; p <= num_params; p++)
+		{
+			type = RL_GET_VALUE(row.series, row.index + p - 1, &item);
+			if (type == RXT_NONE) continue;
+
+			if (params[p].rebol_type == RXT_NONE) params[p].rebol_type = type;
+			else if (params[p].rebol_type != type)
+				return MAKE_ERROR(L"Parameter rows differ in datatypes!");
+
+			switch (type)
+			{
+				case RXT_STRING: tail = sizeof(SQLWCHAR) * RL_SERIES(item.series, RXI_SER_TAIL); break;
+				case RXT_BINARY: tail = RL_SERIES(item.series, RXI_SER_TAIL); break;
+				default:         tail = 0;
+			}
+			if ((SQLLEN)tail > params[p].size) params[p].size = tail;
+		}
+	}
+
+	ODBC_ResetParameters(object, hstmt);										// replaces single row bindings
+
+	for (p = 1; p <= num_params; p++)
+	{
+		switch (params[p].rebol_type)
+		{
+			case RXT_INTEGER: params[p].size = sizeof(SQLBIGINT);   break;
+			case RXT_DECIMAL: params[p].size = sizeof(double);      break;
+			case RXT_LOGIC:   params[p].size = sizeof(SQLCHAR);     break;
+			case RXT_DATE:    params[p].size = sizeof(DATE_STRUCT); break;
+			case RXT_TIME:    params[p].size = sizeof(TIME_STRUCT); break;
+			case RXT_STRING:
+			case RXT_BINARY:  if (params[p].size < 2) params[p].size = 2; break;
+			default:          params[p].size = sizeof(SQLWCHAR);	// all NONE
+		}
+
+		rc = ODBC_BindParameterArray(frm, hstmt, arena, &params[p], p, batch_size);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { error = ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt); goto reset_attributes; }
+	}
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_BIND_TYPE,       (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+	if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)
+		rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR,     status,     0);
+	if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)
+		rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { error = ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt); goto reset_attributes; }
+
+	result   = RL_MAKE_BLOCK(2);
+	statuses = RL_MAKE_BLOCK(num_rows);
+
+	w_success = RL_MAP_WORD("success"); w_info    = RL_MAP_WORD("info");
+	w_error   = RL_MAP_WORD("error");   w_unused  = RL_MAP_WORD("unused");
+	w_unknown = RL_MAP_WORD("unknown");
+
+	// Execute batches
+	//
+	for (first = 0; first < num_rows; first += count)
+	{
+		count = (num_rows - first < batch_size) ? num_rows - first : batch_size;
+
+		for (r = 0; r < count; r++)
+		{
+			RL_GET_VALUE(rows, index + first + r, &row);
+			for (p = 1; p <= num_params; p++)
+			{
+				type = RL_GET_VALUE(row.series, row.index + p - 1, &item);
+				ODBC_SetParameterValue(&params[p], r, &item, type);
+			}
+		}
+
+		rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)count, 0);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { error = ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt); goto reset_attributes; }
+
+		processed = 0;
+		ticks     = ODBC_TRACE_TICKS();
+
+		rc = SQLExecute(hstmt);
+		ODBC_TRACE("SQLExecute", hstmt, ticks, (i64)count, rc);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO && (rc != SQL_ERROR || processed == 0))
+		{
+			error = ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);				// nothing executed at all
+			goto reset_attributes;
+		}
+
+		if (SQLRowCount(hstmt, &affected) == SQL_SUCCESS && affected > 0) total += affected;
+
+		for (r = 0; r < count; r++)
+		{
+			switch (r < processed ? status[r] : SQL_PARAM_UNUSED)
+			{
+				case SQL_PARAM_SUCCESS:           value.int32a = w_success; break;
+				case SQL_PARAM_SUCCESS_WITH_INFO: value.int32a = w_info;    break;
+				case SQL_PARAM_ERROR:             value.int32a = w_error;   break;
+				case SQL_PARAM_UNUSED:            value.int32a = w_unused;  break;
+				default:                          value.int32a = w_unknown;
+			}
+			RL_SET_VALUE(statuses, first + r, value, RXT_WORD);
+		}
+	}
+
+	value.int64  = total;    RL_SET_VALUE(result, 0, value, RXT_INTEGER);
+	value.series = statuses;
+	value.index  = 0;        RL_SET_VALUE(result, 1, value, RXT_BLOCK);
+
+	RXA_SERIES(frm, 1) = result;
+	RXA_INDEX (frm, 1) = 0;
+	RXA_TYPE  (frm, 1) = RXT_BLOCK;
+	error = RXR_VALUE;
+
+reset_attributes:
+	ODBC_ResetParameters(object, hstmt);										// leave the statement ready for single row execution
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE,        (SQLPOINTER)1, 0);
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR,     NULL, 0);
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, NULL, 0);
+
+	return error;
+}
+
+
+/*##############################################################################
+##
+*/  SQLRETURN ODBC_GetCatalog(RXIFRM *frm, SQLHSTMT hstmt, enum GET_CATALOG which, REBSER *block)
+/*
+##############################################################################*/
+{
+	SQLWCHAR     pattern[4][255];
+	SQLSMALLINT  length[4];
+	int          arg;
+	RXIARG       value;
+
+	for (arg = 0; arg < 4; arg++)
+	{
+		if (RL_GET_VALUE(block, arg + 1, &value) == RXT_STRING)
+		{
+			length[arg] = RL_SERIES(value.series, RXI_SER_TAIL);
+			ODBC_StringToSqlWChar(value.series, &pattern[arg][0]);
+		}
+		else length[arg] = 0;
+	}
+
+	switch (which)
+	{
+		case GET_CATALOG_TABLES:
+			return SQLTablesW(hstmt,
+				length[2] == 0 ? NULL : (SQLWCHAR *)&(pattern[2][0]), length[2], // catalog
+				length[1] == 0 ? NULL : (SQLWCHAR *)&(pattern[1][0]), length[1], // schema
+				length[0] == 0 ? NULL : (SQLWCHAR *)&(pattern[0][0]), length[0], // table
+				length[3] == 0 ? NULL : (SQLWCHAR *)&(pattern[3][0]), length[3]  // type
+			);
+			break;
+
+		case GET_CATALOG_COLUMNS:
+			return SQLColumnsW(hstmt,
+				length[3] == 0 ? NULL : (SQLWCHAR *)&(pattern[3][0]), length[3], // catalog
+				length[2] == 0 ? NULL : (SQLWCHAR *)&(pattern[2][0]), length[2], // schema
+				length[0] == 0 ? NULL : (SQLWCHAR *)&(pattern[0][0]), length[0], // table
+				length[1] == 0 ? NULL : (SQLWCHAR *)&(pattern[1][0]), length[1]  // column
+			);
+			break;
+
+		case GET_CATALOG_TYPES:
+			return SQLGetTypeInfoW(hstmt, SQL_ALL_TYPES);
+			break;
+	}
+}
+
+
+/*******************************************************************************
+**
+*/  SQLRETURN ODBC_DescribeResults(RXIFRM *frm, SQLHSTMT hstmt, int num_columns, COLUMN *columns, REBSER *titles)
+/*
+**  Sets up the COLUMNS description, retrievs column titles and column descriptions
+**
+*******************************************************************************/
+{
+	SQLSMALLINT  col;
+	COLUMN      *column;
+	SQLRETURN    rc;
+
+	for (col = 0; col <= num_columns - 1; col++)
+	{
+		column = &columns[col];
+
+		rc = SQLDescribeColW(hstmt, (SQLSMALLINT)(col + 1),
+			&column->title[0], COLUMN_TITLE_SIZE,
+			&column->title_length,
+			&column->sql_type,
+			&column->column_size,
+			&column->precision,
+			&column->nullable
+		);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+	}
+
+	ODBC_MakeTitles(num_columns, columns, titles);
+
+	return SQL_SUCCESS;
+}
+
+
+/*******************************************************************************
+**
+*/  void ODBC_MakeTitles(int num_columns, COLUMN *columns, REBSER *titles)
+/*
+**  Fills TITLES with the REBOL words for the described columns' titles.
+**
+*******************************************************************************/
+{
+	SQLSMALLINT  col;
+	SQLWCHAR     title[COLUMN_TITLE_SIZE * 2 + 2];
 	int          length;
-	char         rebol_word[COLUMN_TITLE_SIZE];
+	char         rebol_word[COLUMN_TITLE_SIZE * 3];
+	RXIARG       value;
+
+	for (col = 0; col <= num_columns - 1; col++)
+	{
+		length  = ODBC_UnCamelCase(columns[col].title, title);
+		WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)title, length, (LPSTR)&rebol_word, sizeof(rebol_word), NULL, NULL);
+
+		value.int32a = RL_MAP_WORD(rebol_word);
+		RL_SET_VALUE(titles, col, value, RXT_WORD);
+	}
+}
+
+
+/*******************************************************************************
+**
+*/  SQLRETURN ODBC_BindColumns(RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, int num_columns, COLUMN *columns, ROWSET *rowset)
+/*
+**  Binds column-wise arrays of ROWSET->SIZE elements per column, so that one
+**  SQLFetch retrieves a whole rowset (block cursor).
+**
+**  Long columns (see ODBC_IsLongColumn) are left unbound and read in chunks
+**  with SQLGetData, as are all columns following the first long column,
+**  because drivers needn't support SQLGetData on columns before bound ones.
+**  Result sets with long columns are fetched a row at a time, as drivers
+**  needn't support SQLGetData with block cursors either.
+**
+**  Bind buffers live as long as the bindings (and in the prepared statement
+**  cache), so they're allocated from the heap, but counted in ARENA.
+**
+*******************************************************************************/
+{
+	SQLSMALLINT  col, first_long;
+	COLUMN      *column;
+	SQLSMALLINT  c_type;
+	int          buffer_size;
+	SQLULEN      requested;
+	SQLRETURN    rc;
+
+	rc = SQLFreeStmt(hstmt, SQL_UNBIND);                                        // Release bindings of any previous result set
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_BIND_TYPE,  (SQLPOINTER)SQL_BIND_BY_COLUMN, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	for (first_long = 0; first_long < num_columns; first_long++)
+	{
+		if (ODBC_IsLongColumn(&columns[first_long])) break;
+	}
+
+	requested = first_long < num_columns ? 1 : rowset->requested;
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)requested, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	rowset->size = requested;
+	if (rc == SQL_SUCCESS_WITH_INFO)                                            // Option value changed (01S02), ask for what we've got
+	{
+		rc = SQLGetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, &rowset->size, 0, NULL);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+		if (rowset->size < 1 || rowset->size > requested) rowset->size = 1;
+	}
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR,   rowset->status,   0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_ROWS_FETCHED_PTR, &rowset->fetched, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	for (col = 0; col <= num_columns - 1; col++)
+	{
+		column = &columns[col];
+		column->value.int64 = 0;
+
+		//-- Bind columns
+		//
+		switch (column->sql_type)
+		{
+			case SQL_SMALLINT: case SQL_INTEGER: case SQL_TINYINT:
+				c_type 		= SQL_C_LONG;
+				buffer_size = sizeof(SQLINTEGER);
+				column->convert = ODBC_ConvertInteger;
+				break;
+
+			case SQL_BIGINT:
+				c_type      = SQL_C_SBIGINT;
+				buffer_size = sizeof(SQLBIGINT);
+				column->convert = ODBC_ConvertBigint;
+				break;
+
+			case SQL_DECIMAL: case SQL_NUMERIC: case SQL_REAL: case SQL_FLOAT: case SQL_DOUBLE:
+				c_type 	    = SQL_C_DOUBLE;
+				buffer_size = sizeof(double);
+				column->convert = ODBC_ConvertDouble;
+				break;
+
+			case SQL_TYPE_DATE:
+				c_type      = SQL_C_TYPE_DATE;
+				buffer_size = sizeof(DATE_STRUCT);
+				column->convert = ODBC_ConvertDate;
+				break;
+
+			case SQL_TYPE_TIME:
+				c_type      = SQL_C_TYPE_TIME;
+				buffer_size = sizeof(TIME_STRUCT);
+				column->convert = ODBC_ConvertTime;
+				break;
+
+			case SQL_TYPE_TIMESTAMP:
+				c_type      = SQL_C_TYPE_TIMESTAMP;
+				buffer_size = sizeof(TIMESTAMP_STRUCT);
+				column->convert = ODBC_ConvertTimestamp;
+				break;
+
+			case SQL_BIT:
+				c_type      = SQL_C_BIT;
+				buffer_size = sizeof(SQLCHAR);
+				column->convert = ODBC_ConvertBit;
+				break;
+
+			case SQL_BINARY: case SQL_VARBINARY: case SQL_LONGVARBINARY:
+				c_type      = SQL_C_BINARY;
+				buffer_size = sizeof(char) * column->column_size;
+				column->convert = ODBC_ConvertBinary;
+				break;
+
+			case SQL_CHAR: case SQL_VARCHAR: case SQL_LONGVARCHAR: case SQL_WCHAR: case SQL_WVARCHAR: case SQL_WLONGVARCHAR:
+			default:
+				c_type      = SQL_C_WCHAR;
+				buffer_size = sizeof(WCHAR) * (column->column_size + 1);
+				column->convert = ODBC_ConvertText;
+				break;
+		}
+
+		column->unbound     = col >= first_long;
+		column->long_data   = column->unbound && ODBC_IsLongColumn(column);
+
+		if (column->long_data) buffer_size = LONG_DATA_CHUNK;
+
+		column->c_type      = c_type;
+		column->buffer_size = buffer_size;
+		column->buffer      = malloc(buffer_size * rowset->size + (column->long_data ? sizeof(SQLWCHAR) : 0));
+		column->lengths     = malloc(sizeof(SQLLEN) * rowset->size);
+		if (column->buffer == NULL || column->lengths == NULL) return MAKE_ERROR(L"Couldn't allocate column buffer!");
+		arena->heap += 2;
+
+		if (column->unbound) continue;
+
+		rc = SQLBindCol(hstmt, (SQLSMALLINT)(col + 1),
+						  column->c_type,
+						  column->buffer,
+						  column->buffer_size,
+						  column->lengths
+		);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+	}
+
+	return SQL_SUCCESS;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_IsLongColumn(COLUMN *column)
+/*
+**  Returns TRUE for long data columns and character or binary columns too
+**  large to bind, including those of unknown size, e.g. nvarchar(max).
+**
+*******************************************************************************/
+{
+	switch (column->sql_type)
+	{
+		case SQL_LONGVARCHAR: case SQL_WLONGVARCHAR: case SQL_LONGVARBINARY:
+			return TRUE;
+
+		case SQL_SMALLINT: case SQL_INTEGER: case SQL_TINYINT: case SQL_BIGINT:
+		case SQL_DECIMAL: case SQL_NUMERIC: case SQL_REAL: case SQL_FLOAT: case SQL_DOUBLE:
+		case SQL_TYPE_DATE: case SQL_TYPE_TIME: case SQL_TYPE_TIMESTAMP: case SQL_BIT:
+			return FALSE;
+
+		default:
+			return column->column_size == 0 || column->column_size > MAX_BOUND_SIZE;
+	}
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_GetData(RXIFRM *frm, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column, LONG_DATA *target, SQLULEN number)
+/*
+**  Reads unbound column COL of the current row, see ODBC_BindColumns.
+**
+**  Returns the REBOL type of COLUMN->VALUE, or -1 with the error set in FRM.
+**
+*******************************************************************************/
+{
+	SQLRETURN    rc;
+	LONGLONG     ticks;
+
+	if (column->long_data) return ODBC_GetLongData(frm, hstmt, col, column, target, number);
+
+	ticks = ODBC_TRACE_TICKS();
+	rc    = SQLGetData(hstmt, (SQLUSMALLINT)(col + 1), column->c_type, column->buffer, column->buffer_size, &column->lengths[0]);
+	ODBC_TRACE("SQLGetData", hstmt, ticks, 0, rc);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
+	{
+		ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+		return -1;
+	}
+
+	return ODBC_ConvertSqlToRebol(column, 0);
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_GetLongData(RXIFRM *frm, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column, LONG_DATA *target, SQLULEN number)
+/*
+**  Reads a long column value of the current row in chunks of LONG_DATA_CHUNK
+**  bytes, so memory use follows the actual instead of the declared size.
+**
+**  Chunks are appended to a series growing with the value, or written to a
+**  file NUMBER-COL.txt (UTF-8) or NUMBER-COL.bin in TARGET's directory, in
+**  which case the FILE! is returned instead of the value.
+**
+**  Returns the REBOL type of COLUMN->VALUE, or -1 with the error set in FRM.
+**
+*******************************************************************************/
+{
+	SQLWCHAR    *text, *start, *path = NULL, name[32];
+	char        *data, *utf8 = NULL;
+	SQLLEN       indicator, chunk, room, total = 0;
+	SQLRETURN    rc;
+	REBSER      *series = NULL;
+	HANDLE       file = INVALID_HANDLE_VALUE;
+	DWORD        written;
+	LONGLONG     ticks;
+	int          wide, carry = 0, error = 0, units, length, i, n = 0;
+
+	name[0] = 0;
+	wide = column->c_type == SQL_C_WCHAR;
+	text = (SQLWCHAR *)column->buffer;                                          // text[0] holds a high surrogate carried over
+	data = (char *)column->buffer + sizeof(SQLWCHAR);                           // into the next chunk when writing UTF-8
+	room = column->buffer_size - (wide ? sizeof(SQLWCHAR) : 0);                 // Data bytes in a full chunk, w/o terminator
+
+	do
+	{
+		ticks = ODBC_TRACE_TICKS();
+		rc    = SQLGetData(hstmt, (SQLUSMALLINT)(col + 1), column->c_type, data, column->buffer_size, &indicator);
+		ODBC_TRACE("SQLGetData", hstmt, ticks, 0, rc);
+		if (rc == SQL_NO_DATA) break;
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
+		{
+			ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+			error = 1;
+			break;
+		}
+
+		if (indicator == SQL_NULL_DATA) return RXT_NONE;
+
+		chunk = (indicator == SQL_NO_TOTAL || indicator > room) ? room : indicator;
+
+		if (target->limit && (total + chunk > target->limit || (indicator != SQL_NO_TOTAL && total + indicator > target->limit)))
+		{
+			MAKE_ERROR(L"Long column value exceeds LONG-LIMIT!");
+			error = 1;
+			break;
+		}
+
+		total += chunk;
+		target->bytes += chunk;
+
+		if (target->directory)
+		{
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				wsprintfW(name, L"%lu-%d.%s", (unsigned long)number, col + 1, wide ? L"txt" : L"bin");
+
+				length = RL_SERIES(target->path, RXI_SER_TAIL);
+				path   = malloc(sizeof(SQLWCHAR) * (length + lstrlenW(name) + 1));
+				utf8   = malloc(LONG_DATA_CHUNK * 2);
+				target->arena->heap += 2;
+				if (path == NULL || utf8 == NULL)
+				{
+					MAKE_ERROR(L"Couldn't allocate long data buffer!");
+					error = 1;
+					break;
+				}
+
+				ODBC_StringToSqlWChar(target->path, path);
+				lstrcpyW(path + length, name);
+
+				file = CreateFileW(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+				if (file == INVALID_HANDLE_VALUE)
+				{
+					MAKE_ERROR(L"Couldn't create long data file!");
+					error = 1;
+					break;
+				}
+			}
+
+			if (wide)
+			{
+				units = chunk / sizeof(SQLWCHAR) + carry;
+				start = text + 1 - carry;
+				carry = units > 0 && start[units - 1] >= 0xD800 && start[units - 1] <= 0xDBFF;
+				if (carry) text[0] = start[--units];
+
+				length = units ? WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)start, units, utf8, LONG_DATA_CHUNK * 2, NULL, NULL) : 0;
+				error  = !WriteFile(file, utf8, length, &written, NULL);
+			}
+			else
+				error  = !WriteFile(file, data, chunk, &written, NULL);
+
+			if (error)
+			{
+				MAKE_ERROR(L"Couldn't write long data file!");
+				break;
+			}
+		}
+		else
+		{
+			if (series == NULL)                                                 // Allocate what the driver announced, if anything
+			{
+				series = RL_MAKE_STRING((indicator == SQL_NO_TOTAL ? chunk : indicator) / (wide ? sizeof(SQLWCHAR) : 1), wide);
+			}
+
+			if (wide) for (i = 0; i < chunk / (SQLLEN)sizeof(SQLWCHAR); i++) RL_SET_CHAR(series, n++, text[i + 1]);
+			else      for (i = 0; i < chunk; i++)                           RL_SET_CHAR(series, n++, (unsigned char)data[i]);
+		}
+	}
+	while (indicator == SQL_NO_TOTAL || indicator > room);
+
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		if (!error && carry)                                                    // Unpaired high surrogate at the end
+		{
+			length = WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)text, 1, utf8, LONG_DATA_CHUNK * 2, NULL, NULL);
+			WriteFile(file, utf8, length, &written, NULL);
+		}
+
+		CloseHandle(file);
+		if (error) DeleteFileW(path);
+	}
+
+	if (path) free(path);
+	if (utf8) free(utf8);
+
+	if (error) return -1;
+
+	if (target->directory && name[0])
+	{
+		length = RL_SERIES(target->directory, RXI_SER_TAIL);
+		series = RL_MAKE_STRING(length + lstrlenW(name), TRUE);
+
+		for (i = 0; i < length; i++)          RL_SET_CHAR(series, n++, RL_GET_CHAR(target->directory, i));
+		for (i = 0; i < lstrlenW(name); i++) RL_SET_CHAR(series, n++, name[i]);
+
+		column->value.series = series;
+		column->value.index  = 0;
+		return RXT_FILE;
+	}
+
+	if (series == NULL) series = RL_MAKE_STRING(0, wide);
+
+	column->value.series = series;
+	column->value.index  = 0;
+	return wide ? RXT_STRING : RXT_BINARY;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_ConvertSqlToRebol(COLUMN *column, SQLULEN row)
+/*
+**  Converts the value of ROW in the column's rowset buffer with the converter
+**  ODBC_BindColumns picked for the column.
+**
+*******************************************************************************/
+{
+	if (column->lengths[row] == SQL_NULL_DATA) return RXT_NONE;
+
+	return column->convert(column, (char *)column->buffer + row * column->buffer_size, column->lengths[row]);
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertInteger(COLUMN *column, char *buffer, SQLLEN length)
+/*
+*******************************************************************************/
+{
+	column->value.int64 = *(SQLINTEGER *)buffer;
+	return RXT_INTEGER;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertBigint(COLUMN *column, char *buffer, SQLLEN length)
+/*
+*******************************************************************************/
+{
+	column->value.int64 = *(SQLBIGINT *)buffer;
+	return RXT_INTEGER;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertDouble(COLUMN *column, char *buffer, SQLLEN length)
+/*
+*******************************************************************************/
+{
+	column->value.dec64 = *(double *)buffer;
+	return RXT_DECIMAL;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertDate(COLUMN *column, char *buffer, SQLLEN length)
+/*
+*******************************************************************************/
+{
+	DATE_STRUCT *date = (DATE_STRUCT *)buffer;
+
+	column->value.int32a = (date->year << 16) | (date->month << 12) | (date->day << 7);
+	return RXT_DATE;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertTime(COLUMN *column, char *buffer, SQLLEN length)
+/*
+*******************************************************************************/
+{
+	TIME_STRUCT *time = (TIME_STRUCT *)buffer;
+
+	column->value.int64 = (time->hour * 3.6e12) + (time->minute * 6e10) + (time->second * 1e9);
+	return RXT_TIME;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertTimestamp(COLUMN *column, char *buffer, SQLLEN length)
+/*
+**  Returns a STRING! formatted as yyyy-mm-dd hh:mm:ss[.f...] like the text
+**  drivers convert timestamps to, with as many fraction digits as the
+**  column's decimal digits (extension commands can't return a DATE! with a
+**  time of day).
+**
+*******************************************************************************/
+{
+	char text[32];
+
+	column->value.series = (REBSER *)ODBC_SqlBinaryToBinary(text, ODBC_FormatTimestamp(text, (TIMESTAMP_STRUCT *)buffer, column->precision));
+	column->value.index  = 0;
+	return RXT_STRING;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertBit(COLUMN *column, char *buffer, SQLLEN length)
+/*
+*******************************************************************************/
+{
+	column->value.int64 = *(SQLCHAR *)buffer;
+	return RXT_LOGIC;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertBinary(COLUMN *column, char *buffer, SQLLEN length)
+/*
+*******************************************************************************/
+{
+	if (length == SQL_NO_TOTAL || length > (SQLLEN)column->buffer_size) length = column->buffer_size; // truncated
+
+	column->value.series = (REBSER *)ODBC_SqlBinaryToBinary(buffer, length);
+	column->value.index  = 0;
+	return RXT_BINARY;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertText(COLUMN *column, char *buffer, SQLLEN length)
+/*
+**  Converts character data (and that of types without a converter of their
+**  own, e.g. GUIDs) bound as SQL_C_WCHAR. LENGTH is in bytes, w/o terminator.
+**
+*******************************************************************************/
+{
+	if (length == SQL_NO_TOTAL || length > (SQLLEN)(column->buffer_size - sizeof(SQLWCHAR)))
+		length = Text_Utf16Length((unsigned short *)buffer, column->buffer_size / sizeof(SQLWCHAR) - 1);
+	else
+		length /= sizeof(SQLWCHAR);
+
+	column->value.series = (REBSER *)ODBC_SqlWCharsToString((SQLWCHAR *)buffer, length);
+	column->value.index  = 0;
+	return RXT_STRING;
+}
+
+
+/*##############################################################################
+##
+*/	RXIEXT int ODBC_Insert(RXIFRM *frm)
+/*
+##  Executes an SQL statement.
+##
+##  Returns:
+##      TRUE for row changing statements, BLOCK! of column titles for
+##      'select'-statements.
+##      Prepares and executes statements on first pass, only executes them
+##      on consecutive envocation.
+##
+##      With the /ASYNC refinement, returns NONE instead and notifies the
+##      port once the statement executed, see ODBC_ExecuteAsync.
+##
+##############################################################################*/
+{
+	REBSER      *object, *arguments;
+	RXIARG       value;
+	RXIARG      *values;
+	i32          index = 0, position, tail,
+				 length, p, num_params;
+	PREPARED_CACHE *cache;
+	SQLRETURN    rc;
+	SQLULEN      row, max_rows;
+	SQLHSTMT     hstmt;
+	RXIARG       v;
+	int          type, rebol_type, pos = 0, prepare, execute, direct, bind, async, result;
+	ARENA       *arena;
+	STATS       *stats;
+	LONGLONG     ticks;
+
+	object     = RXA_OBJECT(frm, 1);											// Retrieve the statement object / statement handle
+	hstmt      = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? (SQLHSTMT)value.addr : hnull;
+	arena      = (RL_GET_FIELD(object, RL_MAP_WORD("arena"),     &value) == RXT_HANDLE) ? (ARENA *)value.addr  : NULL;
+	stats      = ODBC_GetStats(object);
+	if (hstmt == NULL || arena == NULL || stats == NULL) return MAKE_ERROR(L"Invalid statement object!");
+	if (RL_GET_FIELD(object, RL_MAP_WORD("pending"), &value) == RXT_HANDLE) return MAKE_ERROR(L"Statement is still executing!");
+
+	ODBC_StopPrefetch(object);													// rebinds the plan's own rowset buffers
+	ODBC_COUNT(stats, allocated, arena->used);
+	ODBC_ResetArena(arena);														// release buffers of the previous execution
+	row        = 0;
+	direct     = TRUE; prepare = FALSE; execute = FALSE;
+	bind       = FALSE;
+	async      = RXA_LOGIC(frm, 3);
+
+	SQLCloseCursor(hstmt);														// parameters stay bound, see ODBC_BindParameters
+
+	//-- Set number of rows returned by driver --
+	//
+	// This is in the wrong place here
+	// max_rows = 0;
+	// rc = SQLSetStmtAttr(hstmt, SQL_ATTR_MAX_ROWS, &max_rows, SQL_IS_POINTER);
+	// if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	arguments  = RXA_SERIES(frm, 2);
+
+	switch (RL_GET_VALUE(arguments, 0, &value))
+	{
+		// Execute catalog function, when first element in the argument block is a (catalog) word
+		//
+		case RXT_WORD:
+		{
+			// catalog functions replace any prepared statement, keep that cached
+			//
+			if (RL_GET_FIELD(object, RL_MAP_WORD("string"), &v) == RXT_HANDLE)
+			{
+				if ((cache = ODBC_GetCache(object)))
+				{
+					rc = ODBC_RenewStatement(cache, object, &hstmt);
+					if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_DBC, cache->hdbc);
+				}
+				else
+				{
+					free(v.addr);
+					RL_SET_FIELD(object, RL_MAP_WORD("string"), v, RXT_NONE);
+				}
+			}
+
+			rc = ODBC_SetQueryTimeout(object, hstmt);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+			ticks = ODBC_Ticks();
+
+			if      (value.int32a == RL_MAP_WORD("tables"))
+				rc = ODBC_GetCatalog(frm, hstmt, GET_CATALOG_TABLES,  arguments);
+			else if (value.int32a == RL_MAP_WORD("columns"))
+				rc = ODBC_GetCatalog(frm, hstmt, GET_CATALOG_COLUMNS, arguments);
+			else if (value.int32a == RL_MAP_WORD("types"))
+				rc = ODBC_GetCatalog(frm, hstmt, GET_CATALOG_TYPES,   arguments);
+			else
+				return MAKE_ERROR(L"Cannot parse dialect!");
+			ODBC_TRACE("catalog", hstmt, ticks, 0, rc);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+			ODBC_CountExecution(stats, ODBC_Ticks() - ticks);
+
+			if (async) return ODBC_ExecuteAsync(frm, hstmt, object, FALSE, 0, TRUE); // catalog functions run synchronously
+
+			bind = TRUE;
+			break;
+		}
+
+		// Prepare/Execute statement, when first element in the block is a (statement) string
+		//
+		case RXT_STRING:
+		{
+			// prepare statement, unless it is the one prepared last
+			result = ODBC_PrepareSql(frm, object, arena, stats, value.series, &hstmt, &bind);
+			if (result) return result;
+
+			rc = ODBC_SetQueryTimeout(object, hstmt);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+			// execute statement with a block of parameter rows as parameter arrays
+			//
+			if (RL_SERIES(arguments, RXI_SER_TAIL) == 2 && RL_GET_VALUE(arguments, 1, &value) == RXT_BLOCK)
+			{
+				ticks  = ODBC_Ticks();
+				result = ODBC_ExecuteBulk(frm, hstmt, arena, object, value.series, value.index);
+
+				ODBC_CountExecution(stats, ODBC_Ticks() - ticks);
+				return result;
+			}
+
+			// bind parameters, or just set their values if bound already
+			//
+			if (0 < (num_params = RL_SERIES(arguments, RXI_SER_TAIL) - 1)) // the statement string doesn't count as an argument
+			{
+				result = ODBC_BindParameters(frm, hstmt, object, stats, arguments, num_params);
+				if (result) return result;
+			}
+
+			// execute statement
+			//
+			if (async) return ODBC_ExecuteAsync(frm, hstmt, object, TRUE, num_params, bind);
+
+			ticks = ODBC_Ticks();
+
+			rc = SQLExecute(hstmt);
+			ODBC_TRACE("SQLExecute", hstmt, ticks, 1, rc);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+			ODBC_CountExecution(stats, ODBC_Ticks() - ticks);
+
+			break;
+		}
+
+		// unknown dialect, when first element in the block is something other
+		//
+		default:
+			return MAKE_ERROR(L"Cannot parse dialect!");
+	}
+
+	return ODBC_DescribeResult(frm, hstmt, object, arena, bind);
+}
+
+
+/*******************************************************************************
+**
+*/	SQLRETURN ODBC_SetQueryTimeout(REBSER *object, SQLHSTMT hstmt)
+/*
+**  Sets SQL_ATTR_QUERY_TIMEOUT from the statement's QUERY-TIMEOUT option, or
+**  that of its connection if NONE. Timeouts are given as TIME! and rounded
+**  up to whole seconds, no timeout is set for NONE or zero.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	SQLULEN      seconds = 0;
+	i64          timeout = 0;
+
+	if (RL_GET_FIELD(object, RL_MAP_WORD("query-timeout"), &value) == RXT_TIME) timeout = value.int64;
+	else if (RL_GET_FIELD(object, RL_MAP_WORD("database"), &value) == RXT_OBJECT
+		 &&  RL_GET_FIELD(value.addr, RL_MAP_WORD("query-timeout"), &value) == RXT_TIME) timeout = value.int64;
+
+	if (timeout > 0) seconds = (SQLULEN)((timeout + 999999999) / 1000000000);	// nanoseconds
+
+	return SQLSetStmtAttr(hstmt, SQL_ATTR_QUERY_TIMEOUT, (SQLPOINTER)seconds, 0);
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_PrepareSql(RXIFRM *frm, REBSER *object, ARENA *arena, STATS *stats, REBSER *sql, SQLHSTMT *hstmt, int *bind)
+/*
+**  Prepares the SQL string on the statement, unless it is the statement
+**  prepared last. With a prepared statement cache, HSTMT is replaced by the
+**  handle the statement is cached with. BIND is set if the result set
+**  columns have to be described and bound again.
+**
+**  The statement's CURSOR option picks a forward-only (default), static,
+**  keyset-driven or dynamic cursor, the latter three are scrollable with
+**  ODBC_Scroll. Statements prepared with another cursor type don't match.
+**
+**  Returns 0, or the command's result with the error set in FRM.
+**
+*******************************************************************************/
+{
+	SQLTEXT     *string, *previous;
+	PREPARED_CACHE *cache;
+	SQLRETURN    rc;
+	RXIARG       value;
+	LONGLONG     ticks;
+	SQLULEN      hits;
+
+	// retrieve supplied statement
+	string    = ODBC_NormalizeSql(arena, sql);
+	if (string == NULL) return MAKE_ERROR(L"Couldn't allocate statement buffer!");
+
+	string->cursor = SQL_CURSOR_FORWARD_ONLY;
+	if (RL_GET_FIELD(object, RL_MAP_WORD("cursor"), &value) == RXT_WORD)
+	{
+		if      (value.int32a == RL_MAP_WORD("static"))  string->cursor = SQL_CURSOR_STATIC;
+		else if (value.int32a == RL_MAP_WORD("keyset"))  string->cursor = SQL_CURSOR_KEYSET_DRIVEN;
+		else if (value.int32a == RL_MAP_WORD("dynamic")) string->cursor = SQL_CURSOR_DYNAMIC;
+	}
+
+	// compare with previously prepared statement
+	previous  = (RL_GET_FIELD(object, RL_MAP_WORD("string"), &value) == RXT_HANDLE) ? value.addr : NULL;
+
+	if (previous && previous->hash == string->hash && previous->length == string->length && previous->cursor == string->cursor
+	&&  !memcmp(previous->chars, string->chars, sizeof(SQLWCHAR) * string->length))
+	{
+		ODBC_COUNT(stats, hits, 1);												// same statement, already prepared
+	}
+	else if ((string = ODBC_KeepSql(string)) == NULL)
+	{
+		return MAKE_ERROR(L"Couldn't allocate statement buffer!");
+	}
+	else if ((cache = ODBC_GetCache(object)))									// prepare statement or take it from the cache
+	{
+		hits  = cache->hits;
+		ticks = ODBC_Ticks();
+
+		rc = ODBC_PrepareCached(cache, object, string, hstmt, bind);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, *hstmt);
+
+		if (cache->hits != hits) ODBC_COUNT(stats, hits, 1);
+		else
+		{
+			ODBC_COUNT(stats, prepares, 1);
+			ODBC_COUNT(stats, prepare_time, ODBC_Ticks() - ticks);
+		}
+	}
+	else																		// prepare statement
+	{
+		if (previous) free(previous);
+		RL_SET_FIELD(object, RL_MAP_WORD("string"), value, RXT_NONE);
+
+		rc = SQLSetStmtAttr(*hstmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)string->cursor, 0);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { free(string); return ODBC_ReturnError(frm, SQL_HANDLE_STMT, *hstmt); }
+
+		ticks = ODBC_Ticks();
+
+		rc = SQLPrepare(*hstmt, string->chars, string->length);
+		ODBC_TRACE("SQLPrepare", *hstmt, ticks, 0, rc);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { free(string); return ODBC_ReturnError(frm, SQL_HANDLE_STMT, *hstmt); }
+
+		ODBC_COUNT(stats, prepares, 1);
+		ODBC_COUNT(stats, prepare_time, ODBC_Ticks() - ticks);
+
+		value.addr = string; RL_SET_FIELD(object, RL_MAP_WORD("string"), value, RXT_HANDLE); // remember statement text
+		*bind = TRUE;
+	}
+
+	return 0;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_DescribeResult(RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, ARENA *arena, int bind)
+/*
+**  Returns the number of rows affected or the column titles of an executed
+**  statement, describing and binding the result set columns if BIND is set
+**  or the rowset-size changed.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	RXIARG      *values;
+	SQLRETURN    rc;
+	SQLULEN      num_rows, rowset_size;
+	SQLSMALLINT  num_columns;
+	COLUMN      *columns;
+	ROWSET      *rowset;
+	REBSER      *titles;
+
+	rowset      = (RL_GET_FIELD(object, RL_MAP_WORD("rowset"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	rowset_size = (RL_GET_FIELD(object, RL_MAP_WORD("rowset-size"), &value) == RXT_INTEGER && value.int64 > 0) ? (SQLULEN)value.int64 : 1;
+
+	// Return early with number of rows affected for Insert/Update/Delete statements
+	//
+	rc = SQLNumResultCols(hstmt, &num_columns);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	if (!num_columns)
+	{
+		// statement changes rows (insert/update/delete)
+		//
+		rc = SQLRowCount(hstmt, &num_rows);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+		RXA_INT64(frm, 1) = num_rows;
+		RXA_TYPE (frm, 1) = RXT_INTEGER;
+	}
+	else
+	{
+		// statement returns result-set (select, catalog)
+		//
+		if (bind || !rowset || rowset->requested != rowset_size || rowset->result)	// rebind on new statements, changed rowset-size and after later results
+		{
+			ODBC_FreeColumns(object);
+
+			columns = calloc(num_columns, sizeof(COLUMN));
+			values  = malloc(sizeof(RXIARG) * num_columns);
+			rowset  = malloc(sizeof(ROWSET) + sizeof(SQLUSMALLINT) * rowset_size);
+			titles  = RL_MAKE_BLOCK(num_columns); //GC'ed by REBOL
+
+			if (!columns || !titles || !values || !rowset) return MAKE_ERROR(L"Couldn't allocate column buffers!");
+			arena->heap += 3;
+
+			rowset->requested   = rowset->size = rowset_size;
+			rowset->fetched     = rowset->row  = rowset->number = 0;
+			rowset->unnumbered  = FALSE;
+			rowset->num_columns = num_columns;
+			rowset->status      = (SQLUSMALLINT *)(rowset + 1);
+			rowset->result      = FALSE;
+
+			value.addr = columns;	RL_SET_FIELD(object, RL_MAP_WORD("columns"), value, RXT_HANDLE);
+			value.addr = values;	RL_SET_FIELD(object, RL_MAP_WORD("values"),  value, RXT_HANDLE);
+			value.addr = rowset;	RL_SET_FIELD(object, RL_MAP_WORD("rowset"),  value, RXT_HANDLE);
+
+			rc = ODBC_DescribeResults(frm, hstmt, num_columns, columns, titles);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+			value.series = titles; value.index = 0; RL_SET_FIELD(object, RL_MAP_WORD("titles"), value, RXT_BLOCK); // remember column titles
+
+			rc = ODBC_BindColumns(frm, hstmt, arena, num_columns, columns, rowset);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+		}
+		else
+		{
+			if (RL_GET_FIELD(object, RL_MAP_WORD("titles"), &value) == RXT_BLOCK) titles = value.series; // retrieve column titles from previous preparation
+			else																// or from columns taken from the cache
+			{
+				columns = (RL_GET_FIELD(object, RL_MAP_WORD("columns"), &value) == RXT_HANDLE) ? value.addr : NULL;
+				titles  = RL_MAKE_BLOCK(num_columns);
+				if (!columns || !titles) return MAKE_ERROR(L"Couldn't retrieve previous column titles!");
+
+				ODBC_MakeTitles(num_columns, columns, titles);
+				value.series = titles; value.index = 0; RL_SET_FIELD(object, RL_MAP_WORD("titles"), value, RXT_BLOCK);
+			}
+
+			rowset->fetched = rowset->row = rowset->number = 0;				// start over with an empty rowset
+			rowset->unnumbered = FALSE;
+		}
+
+		// Store column titles
+		//
+		RXA_SERIES(frm, 1) = titles;
+		RXA_INDEX (frm, 1) = 0;
+		RXA_TYPE  (frm, 1) = RXT_BLOCK;
+	}
+
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Cancel(RXIFRM *frm)
+/*
+**  Cancels the asynchronous execution or background fetch in progress on a
+**  statement (SQLCancel). The execution then fails with an ODBC CANCELED
+**  error, raised by FINISH or the next COPY. Without processing in progress,
+**  canceling has no effect.
+**
+**  Returns TRUE.
+**
+*******************************************************************************/
+{
+	REBSER      *object;
+	RXIARG       value;
+	SQLHSTMT     hstmt;
+	SQLRETURN    rc;
+
+	object = RXA_OBJECT(frm, 1); // statement object
+
+	hstmt  = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (!hstmt) return MAKE_ERROR(L"Invalid statement object!");
+
+	rc = SQLCancel(hstmt);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_MoreResults(RXIFRM *frm)
+/*
+**  Moves on to the next result of a batch of SQL statements or of a procedure
+**  returning several result sets (SQLMoreResults), describing and binding the
+**  columns of each result set. Rows not copied from the current result set
+**  are discarded.
+**
+**  Returns:
+**      The column titles or the number of rows affected as INSERT does, or
+**      NONE if there are no more results.
+**
+*******************************************************************************/
+{
+	REBSER      *object;
+	RXIARG       value;
+	SQLHSTMT     hstmt;
+	SQLRETURN    rc;
+	ARENA       *arena;
+	ROWSET      *rowset;
+	int          result;
+
+	object = RXA_OBJECT(frm, 1); // statement object
+
+	hstmt  = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	arena  = (RL_GET_FIELD(object, RL_MAP_WORD("arena"),     &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (!hstmt || !arena) return MAKE_ERROR(L"Invalid statement object!");
+	if (RL_GET_FIELD(object, RL_MAP_WORD("pending"), &value) == RXT_HANDLE) return MAKE_ERROR(L"Statement is still executing!");
+
+	ODBC_StopPrefetch(object);													// rebinds the plan's own rowset buffers
+
+	rc = SQLMoreResults(hstmt);
+	if (rc == SQL_NO_DATA) return RXR_NONE;
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	result = ODBC_DescribeResult(frm, hstmt, object, arena, TRUE);
+
+	rowset = (RL_GET_FIELD(object, RL_MAP_WORD("rowset"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (rowset) rowset->result = TRUE;											// bound columns aren't the statement's plan
+
+	return result;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Scroll(RXIFRM *frm)
+/*
+**  Positions a scrollable cursor (see ODBC_PrepareSql) with SQLFetchScroll,
+**  so the next COPY starts at the row scrolled to. Rows skipped are neither
+**  transferred nor converted, which makes paging through large results
+**  cheap.
+**
+**  The orientation is one of FIRST, LAST, ABSOLUTE (OFFSET being the row
+**  number, negative counting from the end) or RELATIVE (OFFSET rows from
+**  the next row COPY would return).
+**
+**  RELATIVE is scrolled to as an absolute row number, unless the driver
+**  couldn't tell the row number after scrolling to the last row or a row
+**  counted from the end. Then SQL_FETCH_RELATIVE is used, with the offset
+**  adjusted for the rows of the current rowset already handed out (and a
+**  rowset fetched ahead in the background).
+**
+**  Returns TRUE, or NONE if there's no row at that position.
+**
+*******************************************************************************/
+{
+	REBSER      *object;
+	RXIARG       value;
+	SQLHSTMT     hstmt;
+	SQLRETURN    rc;
+	SQLSMALLINT  orientation;
+	SQLLEN       offset;
+	SQLULEN      number, ahead;
+	ROWSET      *rowset;
+	STATS       *stats;
+	LONGLONG     ticks;
+	u32          word;
+
+	object = RXA_OBJECT(frm, 1); // statement object
+	word   = RXA_INT32 (frm, 2);
+	offset = (SQLLEN)RXA_INT64(frm, 3);
+
+	hstmt  = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	rowset = (RL_GET_FIELD(object, RL_MAP_WORD("rowset"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+	stats  = ODBC_GetStats(object);
+
+	if (!hstmt || !rowset || !stats) return MAKE_ERROR(L"Invalid statement object!");
+	if (RL_GET_FIELD(object, RL_MAP_WORD("pending"), &value) == RXT_HANDLE) return MAKE_ERROR(L"Statement is still executing!");
+
+	ahead = ODBC_StopPrefetch(object);											// rebinds the plan's own rowset buffers
+
+	if      (word == RL_MAP_WORD("first"))    { orientation = SQL_FETCH_FIRST; offset = 0; }
+	else if (word == RL_MAP_WORD("last"))     { orientation = SQL_FETCH_LAST;  offset = 0; }
+	else if (word == RL_MAP_WORD("absolute"))   orientation = SQL_FETCH_ABSOLUTE;
+	else if (word == RL_MAP_WORD("relative") && rowset->unnumbered)			// from the start of the driver's rowset
+	{
+		orientation = SQL_FETCH_RELATIVE;
+		offset      = (SQLLEN)rowset->row + offset - (SQLLEN)ahead;
+	}
+	else if (word == RL_MAP_WORD("relative"))									// relative to the next row COPY returns,
+	{																			// not to the driver's current rowset
+		orientation = SQL_FETCH_ABSOLUTE;
+		offset      = (SQLLEN)rowset->number + 1 + offset;
+		if (offset < 1) offset = 0;												// before the first row
+	}
+	else return MAKE_ERROR(L"Invalid scroll orientation!");
+
+	ticks = ODBC_Ticks();
+	rc    = SQLFetchScroll(hstmt, orientation, offset);
+	ODBC_TRACE("SQLFetchScroll", hstmt, ticks, (i64)rowset->fetched, rc);
+
+	ODBC_COUNT(stats, fetches, 1);
+	ODBC_COUNT(stats, fetch_time, ODBC_Ticks() - ticks);
+
+	if (rc == SQL_NO_DATA)
+	{
+		rowset->row = rowset->fetched = 0;
+		return RXR_NONE;
+	}
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	ODBC_COUNT(stats, rows, rowset->fetched);
+
+	rowset->row = (orientation == SQL_FETCH_LAST && rowset->fetched > 0) ? rowset->fetched - 1 : 0;
+
+	// Number of the first row of the rowset, not all drivers know it
+	number = 0;
+	rc = SQLGetStmtAttr(hstmt, SQL_ATTR_ROW_NUMBER, &number, 0, NULL);
+	if ((rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) || number == 0)
+	{
+		switch (orientation)
+		{
+			case SQL_FETCH_FIRST:    number = 1; break;
+			case SQL_FETCH_ABSOLUTE: number = (offset > 0) ? (SQLULEN)offset : 0; break;
+			default:                 number = 0;								// LAST or RELATIVE to an unknown row
+		}
+	}
+	rowset->unnumbered = number == 0;
+	rowset->number     = number ? number - 1 + rowset->row : 0;
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Copy(RXIFRM *frm)
+/*
+**  Returns the result set for SQL-Select statements and catalog functions as
+**  as a (result-set) block of (row) blocks.
+**
+**  Rows are fetched a rowset at a time, rows of a rowset not asked for by
+**  COPY/PART are handed out on the next call.
+**
+**  With the /COLUMNS refinement the result set is returned column-wise, see
+**  ODBC_CopyColumns.
+**
+**  With the PREFETCH option set, the next rowset is fetched in the background
+**  while the current one is converted, see ODBC_StartPrefetch.
+**
+*******************************************************************************/
+{
+	COLUMN      *columns;
+	RXIARG      *values, value;
+	REBSER      *object, *records, *record;
+	SQLHSTMT     hstmt;
+	SQLSMALLINT  num_columns;
+	SQLULEN      row;
+	ROWSET      *rowset;
+	PREFETCH    *prefetch;
+	STATS       *stats;
+	LONG_DATA    long_data;
+	LONGLONG     ticks, fetch_time;
+	int          more;
+	i32			 num_rows, i;
+
+	object   = RXA_OBJECT(frm, 1); // statement object
+	num_rows = RXA_INT32( frm, 2);
+
+	hstmt   = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	columns = (RL_GET_FIELD(object, RL_MAP_WORD("columns"),   &value) == RXT_HANDLE) ? value.addr : NULL;
+	values  = (RL_GET_FIELD(object, RL_MAP_WORD("values"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+	rowset  = (RL_GET_FIELD(object, RL_MAP_WORD("rowset"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+	stats   = ODBC_GetStats(object);
+
+	if (!hstmt || !columns || !values || !rowset || !stats) return MAKE_ERROR(L"Invalid statement object!");
+
+	long_data.limit     = (RL_GET_FIELD(object, RL_MAP_WORD("long-limit"),  &value) == RXT_INTEGER) ? (SQLLEN)value.int64 : 0;
+	long_data.directory = (RL_GET_FIELD(object, RL_MAP_WORD("long-target"), &value) == RXT_FILE)    ? value.series : NULL;
+	long_data.path      = (RL_GET_FIELD(object, RL_MAP_WORD("long-path"),   &value) == RXT_STRING)  ? value.series : NULL;
+	if (!long_data.path) long_data.directory = NULL;
+	long_data.arena     = (RL_GET_FIELD(object, RL_MAP_WORD("arena"),       &value) == RXT_HANDLE)  ? value.addr   : NULL;
+	long_data.bytes     = 0;
+	if (!long_data.arena) return MAKE_ERROR(L"Invalid statement object!");
+
+	prefetch = (RL_GET_FIELD(object, RL_MAP_WORD("prefetcher"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (prefetch == NULL && RL_GET_FIELD(object, RL_MAP_WORD("prefetch"), &value) == RXT_LOGIC && value.int32a
+	&&  !columns[rowset->num_columns - 1].unbound)								// SQLGetData needs the row at the cursor
+	{
+		prefetch = ODBC_StartPrefetch(object, hstmt, long_data.arena, columns, rowset);
+		if (prefetch == NULL) return MAKE_ERROR(L"Couldn't start prefetching!");
+	}
+
+	if (num_rows == 0) num_rows = -1;											// all rows
+
+	if (RXA_LOGIC(frm, 3)) return ODBC_CopyColumns(frm, hstmt, object, columns, rowset, prefetch, stats, &long_data, num_rows);
+
+	records = RL_MAKE_BLOCK(128); //GC'ed by REBOL
+	if (records == NULL) return MAKE_ERROR(L"Couldn't allocate rows buffer!");
+
+	num_columns = rowset->num_columns;
+
+	row = 0;
+
+	ticks      = ODBC_Ticks();
+	fetch_time = stats->fetch_time;
+
+	while (row != num_rows)
+	{
+		if ((more = ODBC_NextRow(frm, hstmt, rowset, prefetch, stats)) <= 0)
+		{
+			if (more < 0) return RXR_VALUE;										// Error set by ODBC_NextRow
+			break;
+		}
+
+		record = RL_MAKE_BLOCK(num_columns);
+		if (record == NULL) return MAKE_ERROR(L"Couldn't allocate record block!");
+
+		if (!ODBC_ConvertRow(frm, hstmt, columns, rowset, &long_data, record)) return RXR_VALUE;
+
+		rowset->row++;
+		rowset->number++;
+
+		value.series = record;
+		value.index  = 0;
+		RL_SET_VALUE(records, row++, value, RXT_BLOCK);
+	}
+
+	ODBC_COUNT(stats, bytes, long_data.bytes);
+	ODBC_COUNT(stats, convert_time, ODBC_Ticks() - ticks - (stats->fetch_time - fetch_time));
+	ODBC_TRACE("convert", hstmt, ticks, (i64)row, SQL_SUCCESS);
+
+	RXA_SERIES(frm, 1) = records;
+	RXA_INDEX (frm, 1) = 0;
+	RXA_TYPE  (frm, 1) = RXT_BLOCK;
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ConvertRow(RXIFRM *frm, SQLHSTMT hstmt, COLUMN *columns, ROWSET *rowset, LONG_DATA *long_data, REBSER *record)
+/*
+**  Sets the values of the row at ROWSET->ROW as the first values of RECORD,
+**  overwriting those already there. Bytes converted are added to LONG_DATA.
+**
+**  Returns FALSE with the error set in FRM.
+**
+*******************************************************************************/
+{
+	COLUMN      *column;
+	SQLSMALLINT  col;
+	SQLLEN       length;
+	int          rebol_type;
+
+	for (col = 0; col < rowset->num_columns; col++)
+	{
+		column     = &columns[col];
+		rebol_type = column->unbound
+			? ODBC_GetData(frm, hstmt, col, column, long_data, rowset->number + 1)
+			: ODBC_ConvertSqlToRebol(column, rowset->row);
+
+		if (rebol_type < 0) return FALSE;										// Error set by ODBC_GetData
+
+		RL_SET_VALUE(record, col, column->value, rebol_type);
+
+		length = column->long_data ? 0 : column->lengths[column->unbound ? 0 : rowset->row];
+		if (length > 0) long_data->bytes += length;
+	}
+
+	return TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Fetch(RXIFRM *frm)
+/*
+**  Fetches the next row of the result set into the RECORD block, overwriting
+**  the values of the previous row. FOR-EACH-ROW calls this once per row, so
+**  the result set is never materialized as a whole.
+**
+**  Returns TRUE, or NONE at the end of the result set.
+**
+*******************************************************************************/
+{
+	COLUMN      *columns;
+	RXIARG       value;
+	REBSER      *object, *record;
+	SQLHSTMT     hstmt;
+	ROWSET      *rowset;
+	PREFETCH    *prefetch;
+	STATS       *stats;
+	LONG_DATA    long_data;
+	LONGLONG     ticks, fetch_time;
+	int          more;
+
+	object = RXA_OBJECT(frm, 1); // statement object
+	record = RXA_SERIES(frm, 2);
+
+	hstmt   = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	columns = (RL_GET_FIELD(object, RL_MAP_WORD("columns"),   &value) == RXT_HANDLE) ? value.addr : NULL;
+	rowset  = (RL_GET_FIELD(object, RL_MAP_WORD("rowset"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+	stats   = ODBC_GetStats(object);
+
+	if (!hstmt || !columns || !rowset || !stats) return MAKE_ERROR(L"Invalid statement object!");
+
+	long_data.limit     = (RL_GET_FIELD(object, RL_MAP_WORD("long-limit"),  &value) == RXT_INTEGER) ? (SQLLEN)value.int64 : 0;
+	long_data.directory = (RL_GET_FIELD(object, RL_MAP_WORD("long-target"), &value) == RXT_FILE)    ? value.series : NULL;
+	long_data.path      = (RL_GET_FIELD(object, RL_MAP_WORD("long-path"),   &value) == RXT_STRING)  ? value.series : NULL;
+	if (!long_data.path) long_data.directory = NULL;
+	long_data.arena     = (RL_GET_FIELD(object, RL_MAP_WORD("arena"),       &value) == RXT_HANDLE)  ? value.addr   : NULL;
+	long_data.bytes     = 0;
+	if (!long_data.arena) return MAKE_ERROR(L"Invalid statement object!");
+
+	prefetch = (RL_GET_FIELD(object, RL_MAP_WORD("prefetcher"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (prefetch == NULL && RL_GET_FIELD(object, RL_MAP_WORD("prefetch"), &value) == RXT_LOGIC && value.int32a
+	&&  !columns[rowset->num_columns - 1].unbound)
+	{
+		prefetch = ODBC_StartPrefetch(object, hstmt, long_data.arena, columns, rowset);
+		if (prefetch == NULL) return MAKE_ERROR(L"Couldn't start prefetching!");
+	}
+
+	ticks      = ODBC_Ticks();
+	fetch_time = stats->fetch_time;
+
+	if ((more = ODBC_NextRow(frm, hstmt, rowset, prefetch, stats)) <= 0)
+	{
+		return more < 0 ? RXR_VALUE : RXR_NONE;									// Error set by ODBC_NextRow
+	}
+
+	if (!ODBC_ConvertRow(frm, hstmt, columns, rowset, &long_data, record)) return RXR_VALUE;
+
+	rowset->row++;
+	rowset->number++;
+
+	ODBC_COUNT(stats, bytes, long_data.bytes);
+	ODBC_COUNT(stats, convert_time, ODBC_Ticks() - ticks - (stats->fetch_time - fetch_time));
+	ODBC_TRACE("convert", hstmt, ticks, 1, SQL_SUCCESS);
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Export(RXIFRM *frm)
+/*
+**  Writes the remaining rows of the result set to a file as delimiter
+**  separated UTF-8 text, formatted straight from the rowset buffers without
+**  making REBOL values.
+**
+**  Arguments are the statement object, the local file name, the delimiter,
+**  the quote character (or NONE), the NULL rendering and whether to write
+**  the column titles first. Values containing the quote character, the
+**  delimiter or line breaks are quoted, long text values always.
+**
+**  Returns the number of rows written.
+**
+*******************************************************************************/
+{
+	COLUMN      *columns;
+	RXIARG       value;
+	REBSER      *object, *string;
+	SQLWCHAR    *path, chars[64];
+	SQLHSTMT     hstmt;
+	SQLSMALLINT  col;
+	ROWSET      *rowset;
+	PREFETCH    *prefetch;
+	STATS       *stats;
+	ARENA       *arena;
+	EXPORT       export;
+	LONGLONG     ticks, fetch_time;
+	i64          rows = 0;
+	int          length, more = 0, error = 0;
+
+	object = RXA_OBJECT(frm, 1); // statement object
+
+	hstmt   = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	columns = (RL_GET_FIELD(object, RL_MAP_WORD("columns"),   &value) == RXT_HANDLE) ? value.addr : NULL;
+	rowset  = (RL_GET_FIELD(object, RL_MAP_WORD("rowset"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+	arena   = (RL_GET_FIELD(object, RL_MAP_WORD("arena"),     &value) == RXT_HANDLE) ? value.addr : NULL;
+	stats   = ODBC_GetStats(object);
+
+	if (!hstmt || !columns || !rowset || !arena || !stats) return MAKE_ERROR(L"Invalid statement object!");
+
+	memset(&export, 0, sizeof(export));
+
+	string = RXA_SERIES(frm, 3);												// Delimiter and NULL rendering as UTF-8
+	length = RL_SERIES(string, RXI_SER_TAIL);
+	if (length < 1 || length > 4) return MAKE_ERROR(L"Invalid export delimiter!");
+	ODBC_StringToSqlWChar(string, chars);
+	export.delimiter_length = WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)chars, length, export.delimiter, sizeof(export.delimiter), NULL, NULL);
+
+	if (RXA_TYPE(frm, 4) == RXT_STRING)
+	{
+		string = RXA_SERIES(frm, 4);
+		if (RL_SERIES(string, RXI_SER_TAIL) != 1 || RL_GET_CHAR(string, 0) > 0x7F) return MAKE_ERROR(L"Invalid export quote character!");
+		export.quote = (char)RL_GET_CHAR(string, 0);
+	}
+
+	string = RXA_SERIES(frm, 5);
+	if (RL_SERIES(string, RXI_SER_TAIL) > 16) return MAKE_ERROR(L"Invalid export NULL rendering!");
+	length = ODBC_StringToSqlWChar(string, chars);
+	export.null_length = length ? WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)chars, length, export.null, sizeof(export.null), NULL, NULL) : 0;
+
+	string = RXA_SERIES(frm, 2);												// Local file name
+	length = RL_SERIES(string, RXI_SER_TAIL);
+	path   = malloc(sizeof(SQLWCHAR) * (length + 1));
+	export.buffer  = malloc(EXPORT_BUFFER_SIZE);
+	export.scratch = malloc(EXPORT_SCRATCH_SIZE);
+	arena->heap += 3;
+	if (path == NULL || export.buffer == NULL || export.scratch == NULL)
+	{
+		if (path)           free(path);
+		if (export.buffer)  free(export.buffer);
+		if (export.scratch) free(export.scratch);
+		return MAKE_ERROR(L"Couldn't allocate export buffers!");
+	}
+
+	ODBC_StringToSqlWChar(string, path);
+	path[length] = 0;
+
+	export.file = CreateFileW(path, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (export.file == INVALID_HANDLE_VALUE)
+	{
+		free(path);
+		free(export.buffer);
+		free(export.scratch);
+		return MAKE_ERROR(L"Couldn't create export file!");
+	}
+
+	prefetch = (RL_GET_FIELD(object, RL_MAP_WORD("prefetcher"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (prefetch == NULL && RL_GET_FIELD(object, RL_MAP_WORD("prefetch"), &value) == RXT_LOGIC && value.int32a
+	&&  !columns[rowset->num_columns - 1].unbound)
+	{
+		prefetch = ODBC_StartPrefetch(object, hstmt, arena, columns, rowset);
+		if (prefetch == NULL) error = MAKE_ERROR(L"Couldn't start prefetching!");
+	}
+
+	if (!error && RXA_LOGIC(frm, 6))											// Column titles
+	{
+		for (col = 0; col < rowset->num_columns; col++)
+		{
+			if (col) ODBC_ExportBytes(&export, export.delimiter, export.delimiter_length, TRUE);
+			ODBC_ExportText(&export, columns[col].title, columns[col].title_length, FALSE);
+		}
+		ODBC_ExportBytes(&export, "\r\n", 2, TRUE);
+	}
+
+	ticks      = ODBC_Ticks();
+	fetch_time = stats->fetch_time;
+
+	while (!error && !export.error)
+	{
+		if ((more = ODBC_NextRow(frm, hstmt, rowset, prefetch, stats)) <= 0) break;
+
+		for (col = 0; col < rowset->num_columns; col++)
+		{
+			if (col) ODBC_ExportBytes(&export, export.delimiter, export.delimiter_length, TRUE);
+			if (!ODBC_ExportValue(&export, hstmt, col, &columns[col], rowset->row))
+			{
+				error = ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+				break;
+			}
+		}
+		ODBC_ExportBytes(&export, "\r\n", 2, TRUE);
+
+		rowset->row++;
+		rowset->number++;
+		rows++;
+	}
+
+	if (!error && more >= 0) ODBC_ExportFlush(&export);
+
+	ODBC_COUNT(stats, bytes, export.bytes);
+	ODBC_COUNT(stats, convert_time, ODBC_Ticks() - ticks - (stats->fetch_time - fetch_time));
+	ODBC_TRACE("export", hstmt, ticks, rows, export.error ? SQL_ERROR : SQL_SUCCESS);
+
+	CloseHandle(export.file);
+	if (error || more < 0 || export.error) DeleteFileW(path);
+
+	free(path);
+	free(export.buffer);
+	free(export.scratch);
+
+	if (more < 0) return RXR_VALUE;												// Error set by ODBC_NextRow
+	if (error) return error;
+	if (export.error) return MAKE_ERROR(L"Couldn't write export file!");
+
+	RXA_INT64(frm, 1) = rows;
+	RXA_TYPE (frm, 1) = RXT_INTEGER;
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Import(RXIFRM *frm)
+/*
+**  Loads a CSV file into a table by executing a prepared statement with one
+**  parameter per field, in batches of BATCH-SIZE rows bound as parameter
+**  arrays (SQL_ATTR_PARAMSET_SIZE). The file is memory mapped and parsed in
+**  place, fields are bound as text and converted by the driver.
+**
+**  Arguments are the statement object, the SQL, the local file name, the
+**  delimiter, the quote character (or NONE), the text read as NULL, whether
+**  to skip a header line and the number of rows to commit at a time (0 to
+**  leave the connection's commit mode alone).
+**
+**  Returns:
+**      Block of the number of rows loaded and a block of the line numbers
+**      of rows rejected, either by the driver or for the number of fields.
+**
+*******************************************************************************/
+{
+	IMPORT        import;
+	REBSER       *object, *string, *result;
+	RXIARG        value;
+	SQLHSTMT      hstmt;
+	SQLHDBC       hdbc;
+	SQLRETURN     rc;
+	SQLWCHAR     *path, chars[16];
+	SQLULEN       count = 0, line = 0, first, uncommitted = 0;
+	SQLUINTEGER   autocommit = SQL_AUTOCOMMIT_ON;
+	ARENA        *arena;
+	HANDLE        file, mapping = NULL;
+	LARGE_INTEGER size;
+	const char   *view = NULL, *position, *end;
+	char          delimiter;
+	i64           commit;
+	int           p, length, bind = FALSE, error = 0;
+
+	object = RXA_OBJECT(frm, 1); // statement object
+	commit = RXA_INT64 (frm, 8);
+
+	hstmt  = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	arena  = (RL_GET_FIELD(object, RL_MAP_WORD("arena"),     &value) == RXT_HANDLE) ? value.addr : NULL;
+	hdbc   = (RL_GET_FIELD(object, RL_MAP_WORD("database"),  &value) == RXT_OBJECT
+	      &&  RL_GET_FIELD(value.addr, RL_MAP_WORD("connection"), &value) == RXT_HANDLE) ? value.addr : NULL;
+
+	memset(&import, 0, sizeof(import));
+	import.stats = ODBC_GetStats(object);
+
+	if (!hstmt || !arena || !hdbc || !import.stats) return MAKE_ERROR(L"Invalid statement object!");
+	if (RL_GET_FIELD(object, RL_MAP_WORD("pending"), &value) == RXT_HANDLE) return MAKE_ERROR(L"Statement is still executing!");
+
+	string = RXA_SERIES(frm, 4);												// Delimiter, quote and NULL text
+	if (RL_SERIES(string, RXI_SER_TAIL) != 1 || RL_GET_CHAR(string, 0) > 0x7F) return MAKE_ERROR(L"Invalid import delimiter!");
+	delimiter = (char)RL_GET_CHAR(string, 0);
+
+	if (RXA_TYPE(frm, 5) == RXT_STRING)
+	{
+		string = RXA_SERIES(frm, 5);
+		if (RL_SERIES(string, RXI_SER_TAIL) != 1 || RL_GET_CHAR(string, 0) > 0x7F) return MAKE_ERROR(L"Invalid import quote character!");
+		import.quote = (char)RL_GET_CHAR(string, 0);
+	}
+
+	string = RXA_SERIES(frm, 6);
+	if (RL_SERIES(string, RXI_SER_TAIL) > 16) return MAKE_ERROR(L"Invalid import NULL text!");
+	length = ODBC_StringToSqlWChar(string, chars);
+	import.null_length = length ? WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)chars, length, import.null, sizeof(import.null), NULL, NULL) : 0;
+
+	ODBC_StopPrefetch(object);													// rebinds the plan's own rowset buffers
+	ODBC_COUNT(import.stats, allocated, arena->used);
+	ODBC_ResetArena(arena);														// release buffers of the previous execution
+
+	ODBC_ResetParameters(object, hstmt);
+	SQLCloseCursor(hstmt);
+
+	error = ODBC_PrepareSql(frm, object, arena, import.stats, RXA_SERIES(frm, 2), &hstmt, &bind);
+	if (error) return error;
+
+	rc = ODBC_SetQueryTimeout(object, hstmt);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+	rc = SQLNumParams(hstmt, &import.num_params);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+	if (import.num_params < 1) return MAKE_ERROR(L"Import statement has no parameters!");
+
+	// Allocate batch and parameter arrays, grown with the values by ODBC_ImportBatch
+	//
+	import.batch_size = (RL_GET_FIELD(object, RL_MAP_WORD("batch-size"), &value) == RXT_INTEGER && value.int64 > 0) ? (SQLULEN)value.int64 : 1;
+
+	import.params = ODBC_Alloc(arena, sizeof(PARAMETER) * (import.num_params + 1));
+	import.fields = ODBC_Alloc(arena, sizeof(CSV_FIELD) * import.num_params * import.batch_size);
+	import.lines  = ODBC_Alloc(arena, sizeof(SQLULEN) * import.batch_size);
+	import.status = ODBC_Alloc(arena, sizeof(SQLUSMALLINT) * import.batch_size);
+	import.rows   = ODBC_Alloc(arena, sizeof(SQLULEN) * import.batch_size);
+	if (!import.params || !import.fields || !import.lines || !import.status || !import.rows) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
+
+	memset(import.params, 0, sizeof(PARAMETER) * (import.num_params + 1));
+
+	for (p = 1; p <= import.num_params; p++)
+	{
+		import.params[p].rebol_type = RXT_STRING;
+		import.params[p].size       = sizeof(SQLWCHAR) * 64;
+
+		rc = ODBC_BindParameterArray(frm, hstmt, arena, &import.params[p], p, import.batch_size);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { error = ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt); goto reset_attributes; }
+	}
+
+	rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_BIND_TYPE,       (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+	if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)
+		rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR,     import.status,     0);
+	if (rc == SQL_SUCCESS || rc == SQL_SUCCESS_WITH_INFO)
+		rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &import.processed, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { error = ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt); goto reset_attributes; }
+
+	// Map the file
+	//
+	string = RXA_SERIES(frm, 3);
+	length = RL_SERIES(string, RXI_SER_TAIL);
+	path   = malloc(sizeof(SQLWCHAR) * (length + 1));
+	if (path == NULL) { error = MAKE_ERROR(L"Couldn't allocate file name!"); goto reset_attributes; }
+
+	ODBC_StringToSqlWChar(string, path);
+	path[length] = 0;
+
+	file = CreateFileW(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	free(path);
+	if (file == INVALID_HANDLE_VALUE) { error = MAKE_ERROR(L"Couldn't open import file!"); goto reset_attributes; }
+
+	if (!GetFileSizeEx(file, &size) || (SIZE_T)size.QuadPart != size.QuadPart)
+	{
+		error = MAKE_ERROR(L"Couldn't map import file!");
+		goto close_file;
+	}
+
+	if (size.QuadPart > 0)														// empty files can't be mapped
+	{
+		mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		view    = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+		if (view == NULL) { error = MAKE_ERROR(L"Couldn't map import file!"); goto close_file; }
+	}
+
+	if (commit > 0)																// commit every COMMIT rows
+	{
+		SQLGetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, &autocommit, 0, NULL);
+		rc = SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, SQL_IS_UINTEGER);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) { error = ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc); goto close_file; }
+	}
+
+	// Parse and execute batches
+	//
+	import.rejected = RL_MAKE_BLOCK(16);
+
+	position = view;
+	end      = view + (size_t)size.QuadPart;
+
+	if (end - position >= 3 && !memcmp(position, "\xEF\xBB\xBF", 3)) position += 3;	// UTF-8 byte order mark
+
+	if (RXA_LOGIC(frm, 7) && position < end) ODBC_ParseRecord(&position, end, delimiter, import.quote, NULL, 0, &line);
+
+	while (!error && position < end)
+	{
+		if (*position == '\r' || *position == '\n')								// skip blank lines
+		{
+			if (*position++ == '\n') line++;
+			continue;
+		}
+
+		first = line + 1;
+		if (ODBC_ParseRecord(&position, end, delimiter, import.quote, &import.fields[count * import.num_params], import.num_params, &line) != import.num_params)
+		{
+			value.int64 = first;
+			RL_SET_VALUE(import.rejected, import.num_rejected++, value, RXT_INTEGER);
+			continue;
+		}
+
+		import.lines[count++] = first;
+
+		if (count == import.batch_size || position >= end)
+		{
+			error        = ODBC_ImportBatch(frm, hstmt, arena, &import, count);
+			uncommitted += count;
+			count        = 0;
+
+			if (!error && commit > 0 && uncommitted >= (SQLULEN)commit)
+			{
+				rc = SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT);
+				if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) error = ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+				uncommitted = 0;
+			}
+		}
+	}
+
+	if (!error && count) error = ODBC_ImportBatch(frm, hstmt, arena, &import, count);
+
+	if (commit > 0)
+	{
+		if (!error)
+		{
+			rc = SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) error = ODBC_ReturnError(frm, SQL_HANDLE_DBC, hdbc);
+		}
+		if (error) SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_ROLLBACK);				// rows since the last commit
+
+		SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)(SQLULEN)autocommit, SQL_IS_UINTEGER);
+	}
+
+	if (!error) ODBC_COUNT(import.stats, bytes, size.QuadPart);
+
+close_file:
+	if (view)    UnmapViewOfFile(view);
+	if (mapping) CloseHandle(mapping);
+	CloseHandle(file);
+
+reset_attributes:
+	ODBC_ResetParameters(object, hstmt);										// leave the statement ready for single row execution
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE,        (SQLPOINTER)1, 0);
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR,     NULL, 0);
+	SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, NULL, 0);
+
+	if (error) return error;
+
+	result = RL_MAKE_BLOCK(2);
+
+	value.int64  = import.loaded;   RL_SET_VALUE(result, 0, value, RXT_INTEGER);
+	value.series = import.rejected;
+	value.index  = 0;               RL_SET_VALUE(result, 1, value, RXT_BLOCK);
+
+	RXA_SERIES(frm, 1) = result;
+	RXA_INDEX (frm, 1) = 0;
+	RXA_TYPE  (frm, 1) = RXT_BLOCK;
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ImportBatch(RXIFRM *frm, SQLHSTMT hstmt, ARENA *arena, IMPORT *import, SQLULEN count)
+/*
+**  Fills the parameter arrays with COUNT rows of parsed fields and executes
+**  the statement once. Arrays too small for the longest value are replaced
+**  by ones twice as large (or as large as needed).
+**
+**  Rows with fields that aren't valid UTF-8 are left out of the parameter
+**  arrays, these and rows the driver reports as failed are added to
+**  IMPORT->REJECTED, in line order.
+**
+**  Returns 0, or the command's result with the error set in FRM.
+**
+*******************************************************************************/
+{
+	CSV_FIELD   *field;
+	PARAMETER   *param;
+	SQLULEN      r, w, executed;
+	SQLRETURN    rc;
+	SQLLEN       size;
 	RXIARG       value;
+	LONGLONG     ticks;
+	const char  *bytes;
+	size_t       i, length, longest;
+	int          n = import->num_params, p, units, valid;
+
+	for (p = 1; p <= n; p++)
+	{
+		param   = &import->params[p];
+		longest = 0;
+
+		for (r = 0; r < count; r++)
+		{
+			field = &import->fields[r * n + p - 1];
+			if (field->length > longest) longest = field->length;
+			if (field->quoted == 2 && field->length > import->scratch_size)
+			{
+				import->scratch = ODBC_Alloc(arena, field->length);
+				import->scratch_size = import->scratch ? field->length : 0;
+				if (import->scratch == NULL) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
+			}
+		}
+
+		size = sizeof(SQLWCHAR) * (longest + 1);								// UTF-8 bytes >= UTF-16 units
+		if (size > param->size)
+		{
+			param->size = size > 2 * param->size ? size : 2 * param->size;
+
+			rc = ODBC_BindParameterArray(frm, hstmt, arena, param, p, import->batch_size);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+		}
+	}
+
+	for (r = 0, w = 0; r < count; r++)											// row R of the batch to parameter row W
+	{
+		for (p = 1, valid = TRUE; p <= n && valid; p++)
+		{
+			field = &import->fields[r * n + p - 1];
+			param = &import->params[p];
+
+			if (!field->quoted && (int)field->length == import->null_length && !memcmp(field->start, import->null, field->length))
+			{
+				param->lengths[w] = SQL_NULL_DATA;
+				continue;
+			}
+
+			bytes  = field->start;
+			length = field->length;
+
+			if (field->quoted == 2)												// undo doubled quotes
+			{
+				for (i = 0, length = 0; i < field->length; i++)
+				{
+					import->scratch[length++] = field->start[i];
+					if (field->start[i] == import->quote) i++;
+				}
+				bytes = import->scratch;
+			}
+
+			units = length ? MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, bytes, (int)length, (LPWSTR)((char *)param->buffer + w * param->size), (int)(param->size / sizeof(SQLWCHAR))) : 0;
+			param->lengths[w] = sizeof(SQLWCHAR) * units;
+			valid = units > 0 || length == 0;
+		}
+
+		if (valid) import->rows[w++] = r;
+	}
+	executed = w;
+
+	import->processed = 0;
+
+	if (executed > 0)
+	{
+		rc = SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)executed, 0);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+
+		ticks = ODBC_Ticks();
+
+		rc = SQLExecute(hstmt);
+		ODBC_TRACE("SQLExecute", hstmt, ticks, (i64)executed, rc);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO && (rc != SQL_ERROR || import->processed == 0))
+		{
+			return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);				// nothing executed at all
+		}
+
+		ODBC_CountExecution(import->stats, ODBC_Ticks() - ticks);
+	}
+
+	for (r = 0, w = 0; r < count; r++)
+	{
+		if (w < executed && import->rows[w] == r)								// executed as parameter row W
+		{
+			w++;
+			if (w - 1 < import->processed && import->status[w - 1] != SQL_PARAM_ERROR && import->status[w - 1] != SQL_PARAM_UNUSED)
+			{
+				import->loaded++;
+				continue;
+			}
+		}
+
+		value.int64 = import->lines[r];
+		RL_SET_VALUE(import->rejected, import->num_rejected++, value, RXT_INTEGER);
+	}
+
+	return 0;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ParseRecord(const char **position, const char *end, char delimiter, char quote, CSV_FIELD *fields, int max_fields, SQLULEN *lines)
+/*
+**  Splits the record at POSITION into fields, of which the first MAX_FIELDS
+**  are stored in FIELDS, and advances POSITION past its line end. Quoted
+**  fields may contain delimiters, line breaks and doubled quotes. LINES is
+**  incremented by the lines the record spans.
+**
+**  Returns the number of fields of the record.
+**
+*******************************************************************************/
+{
+	const char *p = *position;
+	CSV_FIELD   field;
+	int         n = 0;
+
+	for (;;)
+	{
+		if (quote && p < end && *p == quote)
+		{
+			field.start  = ++p;
+			field.quoted = 1;
+
+			for (; p < end; p++)												// up to the closing quote
+			{
+				if (*p == '\n') (*lines)++;
+				if (*p != quote) continue;
+				if (p + 1 < end && p[1] == quote) { field.quoted = 2; p++; continue; }
+				break;
+			}
+			field.length = p - field.start;
+
+			if (p < end) p++;
+			while (p < end && *p != delimiter && *p != '\n' && *p != '\r') p++;	// ignore anything after the closing quote
+		}
+		else
+		{
+			field.start  = p;
+			field.quoted = 0;
+			while (p < end && *p != delimiter && *p != '\n' && *p != '\r') p++;
+			field.length = p - field.start;
+		}
+
+		if (n < max_fields) fields[n] = field;
+		n++;
+
+		if (p < end && *p == delimiter) p++;
+		else break;
+	}
+
+	if (p < end && *p == '\r') p++;
+	if (p < end && *p == '\n') p++;
+	(*lines)++;
+
+	*position = p;
+	return n;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ExportValue(EXPORT *export, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column, SQLULEN row)
+/*
+**  Formats the value of ROW in the column's rowset buffer, columns not bound
+**  are read with SQLGetData first.
+**
+**  Returns FALSE if SQLGetData failed.
+**
+*******************************************************************************/
+{
+	DATE_STRUCT      *date;
+	TIME_STRUCT      *time;
+	SQLRETURN         rc;
+	SQLLEN            length;
+	LONGLONG          ticks;
+	char             *buffer, *out;
+	int               i;
+
+	static const char hex[] = "0123456789ABCDEF";
+
+	if (column->long_data) return ODBC_ExportLongValue(export, hstmt, col, column);
+
+	if (column->unbound)
+	{
+		ticks = ODBC_TRACE_TICKS();
+		rc    = SQLGetData(hstmt, (SQLUSMALLINT)(col + 1), column->c_type, column->buffer, column->buffer_size, column->lengths);
+		ODBC_TRACE("SQLGetData", hstmt, ticks, 0, rc);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return FALSE;
+		row = 0;
+	}
+
+	buffer = (char *)column->buffer + row * column->buffer_size;
+	length = column->lengths[row];
+
+	if (length == SQL_NULL_DATA)
+	{
+		ODBC_ExportBytes(export, export->null, export->null_length, FALSE);
+		return TRUE;
+	}
+
+	switch (column->c_type)
+	{
+		case SQL_C_LONG:
+			out = ODBC_ExportReserve(export, 24);
+			export->used += ODBC_FormatInteger(out, *(SQLINTEGER *)buffer);
+			break;
+
+		case SQL_C_SBIGINT:
+			out = ODBC_ExportReserve(export, 24);
+			export->used += ODBC_FormatInteger(out, *(SQLBIGINT *)buffer);
+			break;
+
+		case SQL_C_DOUBLE:
+			out = ODBC_ExportReserve(export, 32);
+			export->used += ODBC_FormatDouble(out, *(double *)buffer);
+			break;
+
+		case SQL_C_TYPE_DATE:
+			date = (DATE_STRUCT *)buffer;
+			out  = ODBC_ExportReserve(export, 16);
+			out += ODBC_FormatDigits(out, date->year, 4);  *out++ = '-';
+			out += ODBC_FormatDigits(out, date->month, 2); *out++ = '-';
+			out += ODBC_FormatDigits(out, date->day, 2);
+			export->used += 10;
+			break;
+
+		case SQL_C_TYPE_TIME:
+			time = (TIME_STRUCT *)buffer;
+			out  = ODBC_ExportReserve(export, 16);
+			out += ODBC_FormatDigits(out, time->hour, 2);   *out++ = ':';
+			out += ODBC_FormatDigits(out, time->minute, 2); *out++ = ':';
+			out += ODBC_FormatDigits(out, time->second, 2);
+			export->used += 8;
+			break;
+
+		case SQL_C_TYPE_TIMESTAMP:
+			out = ODBC_ExportReserve(export, 32);
+			export->used += ODBC_FormatTimestamp(out, (TIMESTAMP_STRUCT *)buffer, column->precision);
+			break;
+
+		case SQL_C_BIT:
+			out = ODBC_ExportReserve(export, 1);
+			out[0] = *(SQLCHAR *)buffer ? '1' : '0';
+			export->used += 1;
+			break;
+
+		case SQL_C_BINARY:
+			if (length == SQL_NO_TOTAL || length > (SQLLEN)column->buffer_size) length = column->buffer_size; // truncated
+			out = ODBC_ExportReserve(export, length * 2);
+			for (i = 0; i < length; i++)
+			{
+				*out++ = hex[((unsigned char)buffer[i]) >> 4];
+				*out++ = hex[((unsigned char)buffer[i]) & 15];
+			}
+			export->used += length * 2;
+			break;
+
+		case SQL_C_WCHAR:
+		default:
+			if (length == SQL_NO_TOTAL || length > (SQLLEN)(column->buffer_size - sizeof(SQLWCHAR)))
+				length = Text_Utf16Length((unsigned short *)buffer, column->buffer_size / sizeof(SQLWCHAR) - 1);
+			else
+				length /= sizeof(SQLWCHAR);
+
+			ODBC_ExportText(export, (SQLWCHAR *)buffer, length, FALSE);
+			break;
+	}
+
+	return TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_ExportLongValue(EXPORT *export, SQLHSTMT hstmt, SQLSMALLINT col, COLUMN *column)
+/*
+**  Formats a long column value read in chunks of LONG_DATA_CHUNK bytes, text
+**  is quoted as a whole. High surrogates ending a chunk are carried over to
+**  the next, as in ODBC_GetLongData.
+**
+**  Returns FALSE if SQLGetData failed.
+**
+*******************************************************************************/
+{
+	SQLWCHAR    *text, *start;
+	SQLLEN       indicator, chunk, room;
+	SQLRETURN    rc;
+	LONGLONG     ticks;
+	char        *data, *out;
+	int          wide, carry = 0, units, i, first = TRUE;
+
+	static const char hex[] = "0123456789ABCDEF";
+
+	wide = column->c_type == SQL_C_WCHAR;
+	text = (SQLWCHAR *)column->buffer;
+	data = (char *)column->buffer + sizeof(SQLWCHAR);
+	room = column->buffer_size - (wide ? sizeof(SQLWCHAR) : 0);
+
+	do
+	{
+		ticks = ODBC_TRACE_TICKS();
+		rc    = SQLGetData(hstmt, (SQLUSMALLINT)(col + 1), column->c_type, data, column->buffer_size, &indicator);
+		ODBC_TRACE("SQLGetData", hstmt, ticks, 0, rc);
+		if (rc == SQL_NO_DATA) break;
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return FALSE;
+
+		if (indicator == SQL_NULL_DATA)
+		{
+			ODBC_ExportBytes(export, export->null, export->null_length, FALSE);
+			return TRUE;
+		}
+
+		if (first && wide && export->quote) ODBC_ExportBytes(export, &export->quote, 1, TRUE);
+		first = FALSE;
+
+		chunk = (indicator == SQL_NO_TOTAL || indicator > room) ? room : indicator;
+
+		if (wide)
+		{
+			units = chunk / sizeof(SQLWCHAR) + carry;
+			start = text + 1 - carry;
+			carry = units > 0 && start[units - 1] >= 0xD800 && start[units - 1] <= 0xDBFF;
+			if (carry) text[0] = start[--units];
+
+			ODBC_ExportText(export, start, units, -1);
+		}
+		else
+		{
+			out = ODBC_ExportReserve(export, chunk * 2);
+			for (i = 0; i < chunk; i++)
+			{
+				*out++ = hex[((unsigned char)data[i]) >> 4];
+				*out++ = hex[((unsigned char)data[i]) & 15];
+			}
+			export->used += chunk * 2;
+		}
+	}
+	while (indicator == SQL_NO_TOTAL || indicator > room);
+
+	if (wide && carry) ODBC_ExportText(export, text, 1, -1);					// Unpaired high surrogate at the end
+	if (wide && export->quote && !first) ODBC_ExportBytes(export, &export->quote, 1, TRUE);
+
+	return TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_ExportText(EXPORT *export, SQLWCHAR *text, int units, int quote)
+/*
+**  Writes UNITS of TEXT as UTF-8, see ODBC_ExportBytes for QUOTE.
+**
+*******************************************************************************/
+{
+	int length;
+
+	length = units ? WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)text, units, export->scratch, EXPORT_SCRATCH_SIZE, NULL, NULL) : 0;
+
+	ODBC_ExportBytes(export, export->scratch, length, quote);
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_ExportBytes(EXPORT *export, char *bytes, size_t length, int quote)
+/*
+**  Writes LENGTH BYTES to the export buffer. With QUOTE FALSE, they're quoted
+**  if they contain the quote character, the (whole) delimiter or line breaks,
+**  with QUOTE -1 only the quote characters are doubled (for values quoted as
+**  a whole by the caller), with QUOTE TRUE they're written as they are (for
+**  delimiters, line breaks and quotes around values).
+**
+*******************************************************************************/
+{
+	char   *out, q = export->quote, *delimiter = export->delimiter;
+	size_t  i, delimiter_length = export->delimiter_length;
+	int     needed = FALSE;
+
+	if (q && quote == FALSE) for (i = 0; i < length && !needed; i++)
+	{
+		needed = bytes[i] == q || bytes[i] == '\r' || bytes[i] == '\n'
+			|| (bytes[i] == delimiter[0] && i + delimiter_length <= length && !memcmp(bytes + i, delimiter, delimiter_length));
+	}
+
+	if (!needed && !(q && quote == -1))
+	{
+		out = ODBC_ExportReserve(export, length);
+		memcpy(out, bytes, length);
+		export->used += length;
+		return;
+	}
+
+	out = ODBC_ExportReserve(export, length * 2 + 2);
+	if (needed) *out++ = q;
+	for (i = 0; i < length; i++)
+	{
+		if (bytes[i] == q) *out++ = q;
+		*out++ = bytes[i];
+	}
+	if (needed) *out++ = q;
+
+	export->used = out - export->buffer;
+}
+
+
+/*******************************************************************************
+**
+*/	char *ODBC_ExportReserve(EXPORT *export, size_t length)
+/*
+**  Returns room for LENGTH bytes at the end of the export buffer, flushing
+**  it first if there isn't enough.
+**
+*******************************************************************************/
+{
+	if (export->used + length > EXPORT_BUFFER_SIZE) ODBC_ExportFlush(export);
 
-	for (col = 0; col <= num_columns - 1; col++)
+	return export->buffer + export->used;
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_ExportFlush(EXPORT *export)
+/*
+*******************************************************************************/
+{
+	DWORD written;
+
+	if (export->used && !export->error)
 	{
-		column = &columns[col];
+		export->error = !WriteFile(export->file, export->buffer, (DWORD)export->used, &written, NULL);
+		export->bytes += export->used;
+	}
+	export->used = 0;
+}
 
-		rc = SQLDescribeColW(hstmt, (SQLSMALLINT)(col + 1),
-			&column->title[0], COLUMN_TITLE_SIZE,
-			&column->title_length,
-			&column->sql_type,
-			&column->column_size,
-			&column->precision,
-			&column->nullable
-		);
-		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
 
-		title = malloc(sizeof(WCHAR) * (column->title_length * 2 + 2));
-		if (title == NULL) return MAKE_ERROR(L"Couldn't allocate column name buffer!");
+/*******************************************************************************
+**
+*/	int ODBC_FormatDigits(char *target, unsigned long value, int width)
+/*
+**  Writes VALUE with WIDTH digits, zero padded. Returns WIDTH.
+**
+*******************************************************************************/
+{
+	int i;
+
+	for (i = width - 1; i >= 0; i--, value /= 10) target[i] = '0' + (char)(value % 10);
 
-		length  = ODBC_UnCamelCase(column->title, title);
-		WideCharToMultiByte(CP_UTF8, 0, (LPCWSTR)title, length, (LPSTR)&rebol_word, COLUMN_TITLE_SIZE, NULL, NULL);
+	return width;
+}
 
-		value.int32a = RL_MAP_WORD(rebol_word);
-		RL_SET_VALUE(titles, col, value, RXT_WORD);
 
-		free(title);
+/*******************************************************************************
+**
+*/	int ODBC_FormatTimestamp(char *target, TIMESTAMP_STRUCT *timestamp, int digits)
+/*
+**  Writes a timestamp as yyyy-mm-dd hh:mm:ss[.f...] with DIGITS (at most 9)
+**  fraction digits, e.g. the column's decimal digits. Returns the length, at
+**  most 29.
+**
+*******************************************************************************/
+{
+	char          *out = target;
+	unsigned long  fraction = timestamp->fraction;							// in nanoseconds
+	int            i;
+
+	out += ODBC_FormatDigits(out, timestamp->year, 4);   *out++ = '-';
+	out += ODBC_FormatDigits(out, timestamp->month, 2);  *out++ = '-';
+	out += ODBC_FormatDigits(out, timestamp->day, 2);    *out++ = ' ';
+	out += ODBC_FormatDigits(out, timestamp->hour, 2);   *out++ = ':';
+	out += ODBC_FormatDigits(out, timestamp->minute, 2); *out++ = ':';
+	out += ODBC_FormatDigits(out, timestamp->second, 2);
+
+	if (digits > 9) digits = 9;
+	if (digits > 0)
+	{
+		for (i = digits; i < 9; i++) fraction /= 10;
+		*out++ = '.';
+		out += ODBC_FormatDigits(out, fraction, digits);
 	}
 
-	return SQL_SUCCESS;
+	return (int)(out - target);
 }
 
 
 /*******************************************************************************
 **
-*/  SQLRETURN ODBC_BindColumns(RXIFRM *frm, SQLHSTMT hstmt, int num_columns, COLUMN *columns, RXIARG *values)
+*/	int ODBC_FormatDouble(char *target, double value)
 /*
+**  Writes VALUE with the fewest significant digits (15 to 17) that read
+**  back as the same double, with a decimal point whatever the C runtime's
+**  LC_NUMERIC locale. Returns the length, at most 24.
+**
+*******************************************************************************/
+{
+	char  point = localeconv()->decimal_point[0];
+	int   length, precision, i;
+
+	for (precision = 15; ; precision++)
+	{
+		length = sprintf(target, "%.*g", precision, value);
+		if (precision == 17 || strtod(target, NULL) == value) break;			// same locale both ways
+	}
+
+	if (point != '.') for (i = 0; i < length; i++) if (target[i] == point) target[i] = '.';
+
+	return length;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_FormatInteger(char *target, i64 value)
+/*
+**  Writes VALUE in decimal. Returns the number of chars written.
+**
+*******************************************************************************/
+{
+	char  digits[24];
+	u64   magnitude = value < 0 ? 0 - (u64)value : (u64)value;
+	int   n = 0, length = 0;
+
+	do { digits[n++] = '0' + (char)(magnitude % 10); magnitude /= 10; } while (magnitude);
+
+	if (value < 0) target[length++] = '-';
+	while (n) target[length++] = digits[--n];
+
+	return length;
+}
+
+
+
+
+
+/*******************************************************************************
+**
+*/	int ODBC_NextRow(RXIFRM *frm, SQLHSTMT hstmt, ROWSET *rowset, PREFETCH *prefetch, STATS *stats)
+/*
+**  Moves ROWSET->ROW to the next row to hand out, skipping rows without data
+**  and fetching the next rowset when the current one is exhausted. With
+**  PREFETCH that's the one fetched in the background. Fetches are counted
+**  in STATS.
+**
+**  Rows the driver failed to fetch (SQL_ROW_ERROR) are errors, as they were
+**  with fetching row by row, with the rowset's diagnostics. The row is
+**  skipped, so copying again goes on with the next row.
+**
+**  Returns TRUE, FALSE at the end of the result set or -1 with the error set
+**  in FRM.
+**
 *******************************************************************************/
 {
-	RXIARG       value;
-	SQLSMALLINT  col;
-	COLUMN      *column;
-	SQLSMALLINT  c_type;
-	void        *buffer;
-	int          buffer_size;
 	SQLRETURN    rc;
+	LONGLONG     ticks;
 
-	for (col = 0; col <= num_columns - 1; col++)
+	for (;;)
 	{
-		column = &columns[col];
-		column->value.int64 = 0;
+		if (rowset->row >= rowset->fetched)										// Fetch next rowset
+		{
+			rowset->row = rowset->fetched = 0;
 
-		//-- Bind columns
-		//
-		switch (column->sql_type)
+			ticks = ODBC_Ticks();
+			rc    = prefetch ? ODBC_FetchAhead(prefetch) : SQLFetch(hstmt);
+			ODBC_TRACE(prefetch ? "prefetch-wait" : "SQLFetch", hstmt, ticks, (i64)rowset->fetched, rc);
+
+			ODBC_COUNT(stats, fetches, 1);
+			ODBC_COUNT(stats, fetch_time, ODBC_Ticks() - ticks);
+			ODBC_COUNT(stats, rows, rowset->fetched);
+
+			if (rc == SQL_NO_DATA) return FALSE;
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO)
+			{
+				ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+				return -1;
+			}
+			continue;
+		}
+
+		if (rowset->status[rowset->row] == SQL_ROW_ERROR)
+		{
+			rowset->row++;
+			rowset->number++;
+			ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+			return -1;
+		}
+
+		if (rowset->status[rowset->row] != SQL_ROW_NOROW) return TRUE;
+
+		rowset->row++;
+	}
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_CopyColumns(RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, COLUMN *columns, ROWSET *rowset, PREFETCH *prefetch, STATS *stats, LONG_DATA *long_data, i32 num_rows)
+/*
+**  Returns the result set column-wise, as a block of the number of rows
+**  followed by one series per column, saving the blocks per row.
+**
+**  Integer and decimal columns are staged as packed 64-bit values and given
+**  as INTEGER! or DECIMAL! words, the scheme makes vectors of the number of
+**  rows for them and has them filled by ODBC_FillVectors. Other columns and
+**  numeric columns with NULLs are returned as blocks of values.
+**
+*******************************************************************************/
+{
+	STAGED      *staged, *stage;
+	COLUMN      *column;
+	REBSER      *result;
+	RXIARG       value;
+	SQLSMALLINT  col, num_columns;
+	SQLULEN      row = 0, capacity;
+	void        *data;
+	LONGLONG     ticks, fetch_time;
+	SQLLEN       length;
+	int          rebol_type, more;
+
+	ODBC_FreeStaged(object);													// Left over from a failed COPY
+
+	num_columns = rowset->num_columns;
+	capacity    = num_rows > 0 ? (SQLULEN)num_rows : rowset->size * 16;
+
+	staged = calloc(num_columns + 1, sizeof(STAGED));							// Last one's RXT_END
+	result = RL_MAKE_BLOCK(num_columns + 1);
+	if (staged == NULL || result == NULL) return MAKE_ERROR(L"Couldn't allocate column buffers!");
+
+	value.addr = staged;
+	RL_SET_FIELD(object, RL_MAP_WORD("staged"), value, RXT_HANDLE);
+
+	value.int64 = 0;
+	RL_SET_VALUE(result, 0, value, RXT_INTEGER);
+
+	for (col = 0; col < num_columns; col++)
+	{
+		stage = &staged[col];
+
+		switch (columns[col].sql_type)
 		{
 			case SQL_SMALLINT: case SQL_INTEGER: case SQL_TINYINT: case SQL_BIGINT:
-				c_type 		= SQL_C_LONG;
-				buffer      = &column->value.int64;
-				buffer_size = sizeof(i64);
+				stage->rebol_type = RXT_INTEGER;
 				break;
 
 			case SQL_DECIMAL: case SQL_NUMERIC: case SQL_REAL: case SQL_FLOAT: case SQL_DOUBLE:
-				c_type 	    = SQL_C_DOUBLE;
-				buffer      = &column->value.dec64;
-				buffer_size = sizeof(double);
+				stage->rebol_type = RXT_DECIMAL;
 				break;
 
-			case SQL_TYPE_DATE:
-				c_type      = SQL_C_TYPE_DATE;
-				buffer_size = sizeof(DATE_STRUCT);
-				buffer      = malloc(buffer_size);
-				if (buffer == NULL) return MAKE_ERROR(L"Couldn't allocate date struct buffer!");
-				break;
+			default:
+				stage->rebol_type = RXT_BLOCK;
+		}
 
-			case SQL_TYPE_TIME:
-				c_type      = SQL_C_TYPE_TIME;
-				buffer_size = sizeof(TIME_STRUCT);
-				buffer      = malloc(buffer_size);
-				if (buffer == NULL) return MAKE_ERROR(L"Couldn't allocate time struct buffer!");
-				break;
+		if (stage->rebol_type == RXT_BLOCK)
+		{
+			stage->block = RL_MAKE_BLOCK(capacity);
+			if (stage->block == NULL) return MAKE_ERROR(L"Couldn't allocate column block!");
+		}
+		else
+		{
+			stage->capacity = capacity;
+			stage->data     = malloc(sizeof(i64) * capacity);
+			if (stage->data == NULL) return MAKE_ERROR(L"Couldn't allocate column buffers!");
+		}
 
-		//	case SQL_TYPE_TIMESTAMP:
-		//		c_type      = SQL_C_TYPE_TIMESTAMP;
-		//		buffer_size = sizeof(TIMESTAMP_STRUCT);
-		//		buffer      = malloc(buffer_size);
-		//		if (buffer == NULL) return MAKE_ERROR(L"Couldn't allocate timestamp struct buffer!");
-		//		break;
+		value.series = stage->block;
+		value.index  = 0;
+		RL_SET_VALUE(result, col + 1, value, stage->block ? RXT_BLOCK : RXT_NONE);
+	}
 
-			case SQL_BIT:
-				c_type      = SQL_C_BIT;
-				buffer      = (char *)&column->value.int64;
-				buffer_size = sizeof(i64);
-				break;
+	ticks      = ODBC_Ticks();
+	fetch_time = stats->fetch_time;
 
-			case SQL_BINARY: case SQL_VARBINARY: case SQL_LONGVARBINARY:
-				c_type      = SQL_C_BINARY;
-				buffer_size = sizeof(char) * column->column_size;
-				buffer      = malloc(buffer_size);
-				if (buffer == NULL) return MAKE_ERROR(L"Couldn't allocate binary buffer!");
-				break;
+	while (row != (SQLULEN)num_rows)
+	{
+		if ((more = ODBC_NextRow(frm, hstmt, rowset, prefetch, stats)) <= 0)
+		{
+			if (more < 0) return RXR_VALUE;										// Error set by ODBC_NextRow
+			break;
+		}
 
-			case SQL_CHAR: case SQL_VARCHAR: case SQL_LONGVARCHAR: case SQL_WCHAR: case SQL_WVARCHAR: case SQL_WLONGVARCHAR:
-			default:
-				c_type      = SQL_C_WCHAR;
-				buffer_size = sizeof(WCHAR) * (column->column_size + 1);
-				buffer      = malloc(buffer_size);
-				if (buffer == NULL) return MAKE_ERROR(L"Couldn't allocate string buffer!");
-				break;
+		for (col = 0; col < num_columns; col++)
+		{
+			column     = &columns[col];
+			stage      = &staged[col];
+			rebol_type = column->unbound
+				? ODBC_GetData(frm, hstmt, col, column, long_data, rowset->number + 1)
+				: ODBC_ConvertSqlToRebol(column, rowset->row);
+
+			if (rebol_type < 0) return RXR_VALUE;								// Error set by ODBC_GetData
+
+			length = column->long_data ? 0 : column->lengths[column->unbound ? 0 : rowset->row];
+			if (length > 0) long_data->bytes += length;
+
+			if (stage->rebol_type != RXT_BLOCK && rebol_type != stage->rebol_type)
+			{
+				if (!ODBC_UnstageColumn(stage, result, col)) return MAKE_ERROR(L"Couldn't allocate column block!");
+			}
+
+			if (stage->rebol_type == RXT_BLOCK)
+			{
+				RL_SET_VALUE(stage->block, row, column->value, rebol_type);
+				continue;
+			}
+
+			if (stage->count == stage->capacity)
+			{
+				data = realloc(stage->data, sizeof(i64) * stage->capacity * 2);
+				if (data == NULL) return MAKE_ERROR(L"Couldn't allocate column buffers!");
+
+				stage->data      = data;
+				stage->capacity *= 2;
+			}
+
+			if (rebol_type == RXT_INTEGER) ((i64    *)stage->data)[stage->count++] = column->value.int64;
+			else                           ((double *)stage->data)[stage->count++] = column->value.dec64;
+		}
+
+		rowset->row++;
+		rowset->number++;
+		row++;
+	}
+
+	ODBC_COUNT(stats, bytes, long_data->bytes);
+	ODBC_COUNT(stats, convert_time, ODBC_Ticks() - ticks - (stats->fetch_time - fetch_time));
+	ODBC_TRACE("convert", hstmt, ticks, (i64)row, SQL_SUCCESS);
+
+	value.int64 = row;
+	RL_SET_VALUE(result, 0, value, RXT_INTEGER);
+
+	for (col = 0; col < num_columns; col++) if (staged[col].rebol_type != RXT_BLOCK)
+	{
+		value.int32a = RL_MAP_WORD(staged[col].rebol_type == RXT_INTEGER ? "integer!" : "decimal!");
+		RL_SET_VALUE(result, col + 1, value, RXT_WORD);
+	}
+
+	RXA_SERIES(frm, 1) = result;
+	RXA_INDEX (frm, 1) = 0;
+	RXA_TYPE  (frm, 1) = RXT_BLOCK;
+	return RXR_VALUE;
+}
+
+
+/*******************************************************************************
+**
+*/	int ODBC_UnstageColumn(STAGED *stage, REBSER *result, int col)
+/*
+**  Turns a staged numeric column into a block of values, for columns with
+**  NULLs (or values of unexpected types) which don't fit a vector.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	SQLULEN      i;
+
+	stage->block = RL_MAKE_BLOCK(stage->capacity);
+	if (stage->block == NULL) return FALSE;
+
+	for (i = 0; i < stage->count; i++)
+	{
+		if (stage->rebol_type == RXT_INTEGER) value.int64 = ((i64    *)stage->data)[i];
+		else                                  value.dec64 = ((double *)stage->data)[i];
+
+		RL_SET_VALUE(stage->block, i, value, stage->rebol_type);
+	}
+
+	free(stage->data);
+	stage->data       = NULL;
+	stage->count      = 0;
+	stage->rebol_type = RXT_BLOCK;
+
+	value.series = stage->block;
+	value.index  = 0;
+	RL_SET_VALUE(result, col + 1, value, RXT_BLOCK);
+
+	return TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_FillVectors(RXIFRM *frm)
+/*
+**  Copies the values staged by ODBC_CopyColumns into the vectors the scheme
+**  made for them, in place of the INTEGER! and DECIMAL! words.
+**
+*******************************************************************************/
+{
+	REBSER      *object, *vectors;
+	STAGED      *staged;
+	RXIARG       value;
+	int          col;
+
+	object  = RXA_OBJECT(frm, 1);
+	vectors = RXA_SERIES(frm, 2);
+
+	staged  = (RL_GET_FIELD(object, RL_MAP_WORD("staged"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (staged == NULL) return MAKE_ERROR(L"No staged columns!");
+
+	for (col = 0; staged[col].rebol_type != RXT_END; col++)
+	{
+		if (staged[col].rebol_type == RXT_BLOCK) continue;
+
+		if (RL_GET_VALUE(vectors, RXA_INDEX(frm, 2) + col, &value) != RXT_VECTOR
+		||  RL_SERIES(value.series, RXI_SER_WIDE) != sizeof(i64)
+		||  RL_SERIES(value.series, RXI_SER_TAIL) <  staged[col].count)
+		{
+			ODBC_FreeStaged(object);
+			return MAKE_ERROR(L"Invalid column vector!");
 		}
 
-		column->c_type      = c_type;
-		column->buffer      = buffer;
-		column->buffer_size = buffer_size;
+		memcpy((void *)RL_SERIES(value.series, RXI_SER_DATA), staged[col].data, sizeof(i64) * staged[col].count);
+	}
+
+	ODBC_FreeStaged(object);
+
+	return RXR_TRUE;
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_FreeStaged(REBSER *statement)
+/*
+*******************************************************************************/
+{
+	RXIARG       value;
+	STAGED      *staged;
+	int          col;
+
+	if (RL_GET_FIELD(statement, RL_MAP_WORD("staged"), &value) != RXT_HANDLE) return;
+
+	staged = value.addr;
+	for (col = 0; staged[col].rebol_type != RXT_END; col++) if (staged[col].data) free(staged[col].data);
+	free(staged);
+
+	RL_SET_FIELD(statement, RL_MAP_WORD("staged"), value, RXT_NONE);
+}
+
+
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_ExecuteAsync(RXIFRM *frm, SQLHSTMT hstmt, REBSER *object, int execute, int num_params, int bind)
+/*
+**  Starts executing the prepared statement without waiting for it to
+**  complete, the port given with INSERT-ODBC/ASYNC gets a READ event when
+**  it has. ODBC_Finish then returns what ODBC_Insert would have returned.
+**
+**  Drivers supporting SQL_ATTR_ASYNC_ENABLE are polled by a timer, other
+**  drivers execute the statement on a worker thread. Either way completions
+**  arrive as messages to a hidden window, processed by the interpreter
+**  thread while it WAITs.
+**
+**  With EXECUTE not set the statement already executed (catalog functions),
+**  just the event is sent.
+**
+*******************************************************************************/
+{
+	PENDING     *task;
+	RXIARG       value;
+	WNDCLASSW    wc;
+
+	if (ODBC_Window == NULL)
+	{
+		memset(&wc, 0, sizeof(wc));
+		wc.lpfnWndProc   = ODBC_WindowProc;
+		wc.hInstance     = GetModuleHandleW(NULL);
+		wc.lpszClassName = L"REBOL ODBC";
+
+		RegisterClassW(&wc);
+		ODBC_Window = CreateWindowExW(0, wc.lpszClassName, L"", 0, 0, 0, 0, 0, HWND_MESSAGE, NULL, wc.hInstance, NULL);
+		if (ODBC_Window == NULL) return MAKE_ERROR(L"Couldn't create notification window!");
+	}
+
+	task = calloc(1, sizeof(PENDING));
+	if (task == NULL) return MAKE_ERROR(L"Couldn't allocate execution!");
+
+	task->hstmt      = hstmt;
+	task->started    = ODBC_Ticks();
+	task->port       = RXA_OBJECT(frm, 4);
+	task->num_params = num_params;
+	task->bind       = bind;
+	task->rc         = SQL_SUCCESS;
+
+	if (execute)
+	{
+		task->rc      = SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, SQL_IS_UINTEGER);
+		task->polling = task->rc == SQL_SUCCESS || task->rc == SQL_SUCCESS_WITH_INFO;
+
+		if (task->polling)
+		{
+			task->rc = SQLExecute(hstmt);
+			if (task->rc == SQL_STILL_EXECUTING && !SetTimer(ODBC_Window, (UINT_PTR)task, ASYNC_POLL_INTERVAL, NULL))
+			{
+				SQLCancel(hstmt);
+				while (SQLExecute(hstmt) == SQL_STILL_EXECUTING) Sleep(1);
+				SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, SQL_IS_UINTEGER);
+				free(task);
+				return MAKE_ERROR(L"Couldn't start polling execution!");
+			}
+		}
+		else
+		{
+			task->thread = CreateThread(NULL, 0, ODBC_ExecuteThread, task, 0, NULL);
+			if (task->thread == NULL) { free(task); return MAKE_ERROR(L"Couldn't start execution thread!"); }
+		}
+	}
 
-		rc = SQLBindCol(hstmt, (SQLSMALLINT)(col + 1),
-						  column->c_type,
-			 (SQLPOINTER*)column->buffer,
-						  column->buffer_size,
-			(SQLINTEGER*)&column->buffer_length
-		);
-		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+	if (!task->thread && task->rc != SQL_STILL_EXECUTING)						// completed already, notify on next WAIT
+	{
+		if (execute) ODBC_TRACE("SQLExecute", hstmt, task->started, 1, task->rc);
+		task->ended  = ODBC_Ticks();
+		task->done   = TRUE;
+		task->posted = TRUE;
+		PostMessageW(ODBC_Window, WM_ODBC_EXECUTED, 0, (LPARAM)task);
 	}
 
-	return SQL_SUCCESS;
+	value.addr = task;
+	RL_SET_FIELD(object, RL_MAP_WORD("pending"), value, RXT_HANDLE);
+
+	value.series = RXA_SERIES(frm, 2);											// keep bound series data from being collected
+	value.index  = 0;
+	RL_SET_FIELD(object, RL_MAP_WORD("request"), value, RXT_BLOCK);
+
+	return RXR_NONE;
 }
 
 
 /*******************************************************************************
 **
-*/	RXIEXT int ODBC_ConvertSqlToRebol(COLUMN *column)
+*/	DWORD WINAPI ODBC_ExecuteThread(void *task)
 /*
 *******************************************************************************/
 {
-	TIME_STRUCT *time;
-	DATE_STRUCT *date;
-	TIMESTAMP_STRUCT *timestamp;
+	PENDING     *pending = task;
 
-	if (column->buffer_length == SQL_NULL_DATA) return RXT_NONE;
+	pending->rc     = SQLExecute(pending->hstmt);
+	ODBC_TRACE("SQLExecute", pending->hstmt, pending->started, 1, pending->rc);
+	pending->ended  = ODBC_Ticks();
+	pending->posted = TRUE;
+	PostMessageW(ODBC_Window, WM_ODBC_EXECUTED, 0, (LPARAM)pending);
 
-	switch (column->sql_type)
+	return 0;
+}
+
+
+/*******************************************************************************
+**
+*/	LRESULT CALLBACK ODBC_WindowProc(HWND hwnd, UINT message, WPARAM wparam, LPARAM lparam)
+/*
+**  Polls executions of drivers supporting SQL_ATTR_ASYNC_ENABLE and turns
+**  completions into READ events on the ports waiting for them.
+**
+*******************************************************************************/
+{
+	PENDING     *task;
+	REBEVT       event;
+
+	switch (message)
 	{
-		case SQL_TINYINT:
-		case SQL_SMALLINT:
-		case SQL_INTEGER:
-		case SQL_BIGINT:
-			return RXT_INTEGER;
-
-		case SQL_NUMERIC:
-		case SQL_REAL:
-		case SQL_FLOAT:
-		case SQL_DOUBLE:
-		case SQL_DECIMAL:
-			return RXT_DECIMAL;
-
-		case SQL_TYPE_DATE:
-			date = (DATE_STRUCT *)column->buffer;
-			column->value.int32a = (date->year << 16) | (date->month << 12) | (date->day << 7);
-			return RXT_DATE;
-
-		case SQL_TYPE_TIME:
-			time = (TIME_STRUCT *)column->buffer;
-			column->value.int64 = (time->hour * 3.6e12) + (time->minute * 6e10) + (time->second * 1e9);
-			return RXT_TIME;
-
-	//	case SQL_TYPE_TIMESTAMP:
-	//		timestamp = (TIMESTAMP_STRUCT *)column->buffer;
-	//		column->value.int64 = (10 * 3.6e12) + (30 * 6e10) + (15 * 1e9);
-	//		column->value.int32a = (2012 << 16) | (8 << 12) | (31 << 7);
-	//		return RXT_DATE; // RXT_DATE || RXT_TIME
-
-		case SQL_BIT:
-			return RXT_LOGIC;
-
-		case SQL_BINARY:
-		case SQL_VARBINARY:
-		case SQL_LONGVARBINARY:
-			column->value.series = (REBSER *)ODBC_SqlBinaryToBinary((char *)column->buffer, column->buffer_length);
-			column->value.index  = 0;
-			return RXT_BINARY;
-
-		case SQL_CHAR:
-		case SQL_VARCHAR:
-		case SQL_LONGVARCHAR:
-		case SQL_WCHAR:
-		case SQL_WVARCHAR:
-		case SQL_WLONGVARCHAR:
-		case SQL_GUID:
-			column->value.series = (REBSER *)ODBC_SqlWCharToString((SQLWCHAR *)column->buffer);
-			column->value.index  = 0;
-			return RXT_STRING;
+		case WM_TIMER:
+			task = (PENDING *)wparam;
+			if ((task->rc = SQLExecute(task->hstmt)) == SQL_STILL_EXECUTING) return 0;
+
+			ODBC_TRACE("SQLExecute", task->hstmt, task->started, 1, task->rc);
+			task->ended = ODBC_Ticks();
+			KillTimer(hwnd, wparam);
+			break;
+
+		case WM_ODBC_EXECUTED:
+			task = (PENDING *)lparam;
+			task->delivered = TRUE;
+			if (task->orphaned) { free(task); return 0; }						// finished or closed in the meantime
+			break;
 
 		default:
-			column->value.series = (REBSER *)ODBC_SqlWCharToString((SQLWCHAR *)column->buffer);
-			column->value.index  = 0;
-			return RXT_STRING;
+			return DefWindowProcW(hwnd, message, wparam, lparam);
 	}
+
+	task->done = TRUE;
+
+	memset(&event, 0, sizeof(event));
+	event.type  = EVT_READ;
+	event.model = EVM_PORT;
+	event.ser   = task->port;
+	RL_EVENT(&event);
+
+	return 0;
 }
 
 
-/*##############################################################################
-##
-*/	RXIEXT int ODBC_Insert(RXIFRM *frm)
+/*******************************************************************************
+**
+*/	RXIEXT int ODBC_Finish(RXIFRM *frm)
 /*
-##  Executes an SQL statement.
-##
-##  Returns:
-##      TRUE for row changing statements, BLOCK! of column titles for
-##      'select'-statements.
-##      Prepares and executes statements on first pass, only executes them
-##      on consecutive envocation.
-##
-##############################################################################*/
+**  Waits for a statement's asynchronous execution to complete, returns what
+**  ODBC_Insert would have returned for a synchronous one.
+**
+*******************************************************************************/
 {
-	REBSER      *object, *arguments, *statement, *previous;
+	REBSER      *object;
 	RXIARG       value;
-	RXIARG      *values;
-	i32          index = 0, position, tail,
-				 length, p, num_params;
-	WCHAR       *string;
-	SQLRETURN    rc;
-	SQLULEN      row, num_rows, max_rows;
-	SQLSMALLINT  col, num_columns;
+	PENDING     *task;
+	ARENA       *arena;
+	STATS       *stats;
 	SQLHSTMT     hstmt;
-	RXIARG       v;
-	int          type, rebol_type, pos = 0, prepare, execute, direct;
-	PARAMETER   *params;
-	COLUMN      *columns;
-	REBSER      *titles, *records;
+	SQLRETURN    rc;
+	int          result, bind;
 
-	object     = RXA_OBJECT(frm, 1);											// Retrieve the statement object / statement handle
-	hstmt      = (RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? (SQLHSTMT)value.addr : hnull;
-	if (hstmt == NULL) return MAKE_ERROR(L"Invalid statement object!");
-	row        = 0;
-	direct     = TRUE; prepare = FALSE; execute = FALSE;
+	object = RXA_OBJECT(frm, 1);
+	task   = (RL_GET_FIELD(object, RL_MAP_WORD("pending"), &value) == RXT_HANDLE) ? value.addr : NULL;
+	arena  = (RL_GET_FIELD(object, RL_MAP_WORD("arena"),   &value) == RXT_HANDLE) ? value.addr : NULL;
+	if (task == NULL || arena == NULL) return MAKE_ERROR(L"No pending execution!");
 
-	SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
-	SQLCloseCursor(hstmt);
+	if (task->thread) WaitForSingleObject(task->thread, INFINITE);
+	else if (!task->done)
+	{
+		KillTimer(ODBC_Window, (UINT_PTR)task);
+		while ((task->rc = SQLExecute(task->hstmt)) == SQL_STILL_EXECUTING) Sleep(1);
+		task->done = TRUE;
+	}
 
-	//-- Set number of rows returned by driver --
-	//
-	// This is in the wrong place here
-	// max_rows = 0;
-	// rc = SQLSetStmtAttr(hstmt, SQL_ATTR_MAX_ROWS, &max_rows, SQL_IS_POINTER);
-	// if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+	if (!task->ended) task->ended = ODBC_Ticks();
+	if ((stats = ODBC_GetStats(object))) ODBC_CountExecution(stats, task->ended - task->started);
 
-	arguments  = RXA_SERIES(frm, 2);
+	hstmt  = task->hstmt;
+	rc     = task->rc;
+	bind   = task->bind;
+	result = (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) ? ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt) : RXR_NONE;
 
-	switch (RL_GET_VALUE(arguments, 0, &value))
+	ODBC_FreePending(object);
+
+	if (result != RXR_NONE) return result;
+
+	return ODBC_DescribeResult(frm, hstmt, object, arena, bind);
+}
+
+
+/*******************************************************************************
+**
+*/	void ODBC_FreePending(REBSER *statement)
+/*
+**  Frees a statement's pending execution, canceling it if it's still running.
+**  Executions with a completion message yet to be processed are left for
+**  ODBC_WindowProc to free.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	PENDING     *task;
+
+	if (RL_GET_FIELD(statement, RL_MAP_WORD("pending"), &value) != RXT_HANDLE) return;
+
+	task = value.addr;
+
+	if (task->thread)
 	{
-		// Execute catalog function, when first element in the argument block is a (catalog) word
-		//
-		case RXT_WORD:
+		if (WaitForSingleObject(task->thread, 0) == WAIT_TIMEOUT)
 		{
-			if      (value.int32a == RL_MAP_WORD("tables"))
-				rc = ODBC_GetCatalog(frm, hstmt, GET_CATALOG_TABLES,  arguments);
-			else if (value.int32a == RL_MAP_WORD("columns"))
-				rc = ODBC_GetCatalog(frm, hstmt, GET_CATALOG_COLUMNS, arguments);
-			else if (value.int32a == RL_MAP_WORD("types"))
-				rc = ODBC_GetCatalog(frm, hstmt, GET_CATALOG_TYPES,   arguments);
-			break;
+			SQLCancel(task->hstmt);
+			WaitForSingleObject(task->thread, INFINITE);
 		}
+		CloseHandle(task->thread);
+	}
+	else if (task->polling && !task->done)
+	{
+		KillTimer(ODBC_Window, (UINT_PTR)task);
+		SQLCancel(task->hstmt);
+		while (SQLExecute(task->hstmt) == SQL_STILL_EXECUTING) Sleep(1);
+	}
 
-		// Prepare/Execute statement, when first element in the block is a (statement) string
-		//
-		case RXT_STRING:
-		{
-			// retrieve supplied statement
-			statement = value.series;
-			tail      = RL_SERIES(statement, RXI_SER_TAIL);
+	if (task->polling) SQLSetStmtAttr(task->hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, SQL_IS_UINTEGER);
 
-			// compare with previously prepared statement
-			previous  = (REBSER*)(RL_GET_FIELD(object, RL_MAP_WORD("string"), &value) == RXT_HANDLE) ? value.addr : hnull;
+	if (task->posted && !task->delivered) task->orphaned = TRUE;
+	else free(task);
 
-			// prepare statement
-			if (statement != previous)
-			{
-				string    = malloc(sizeof(WCHAR) * tail);
-				if (string == NULL) return MAKE_ERROR(L"Couldn't allocate statement buffer!");
+	RL_SET_FIELD(statement, RL_MAP_WORD("pending"), value, RXT_NONE);
+	RL_SET_FIELD(statement, RL_MAP_WORD("request"), value, RXT_NONE);
+}
 
-				length 	  = ODBC_StringToSqlWChar(statement, string);
 
-				rc = SQLPrepare(hstmt, (SQLWCHAR *)string, length);
-				if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+/*******************************************************************************
+**
+*/	PREFETCH *ODBC_StartPrefetch(REBSER *object, SQLHSTMT hstmt, ARENA *arena, COLUMN *columns, ROWSET *rowset)
+/*
+**  Sets up a second rowset buffer and a helper thread fetching into it, so
+**  the driver fetches rowset N+1 while COPY converts rowset N. Result sets
+**  with unbound columns aren't prefetched, as SQLGetData reads at the cursor.
+**
+**  The buffers live in the statement's arena, until ODBC_StopPrefetch (on
+**  the next INSERT or CLOSE) rebinds the plan's own ones.
+**
+*******************************************************************************/
+{
+	PREFETCH    *prefetch;
+	RXIARG       value;
+	int          col, num_columns;
 
-				value.addr = statement; RL_SET_FIELD(object, RL_MAP_WORD("string"), value, RXT_HANDLE); // remember statement string handle
-			}
+	num_columns = rowset->num_columns;
 
-			// bind parameters
-			//
-			if (0 < (num_params = RL_SERIES(arguments, RXI_SER_TAIL) - 1)) // the statement string doesn't count as an argument
-			{
-				// Allocate parameter buffer.
-				//
-				params = malloc(sizeof(PARAMETER) * (num_params + 1));
-				if (params == NULL) return MAKE_ERROR(L"Couldn't allocate parameter buffer!");
-
-				// Bind parameters
-				//
-				for (p = 1; p <= num_params; p++)
-				{
-					type = RL_GET_VALUE(arguments, ++index, &params[p].value);
+	prefetch = ODBC_Alloc(arena, sizeof(PREFETCH));
+	if (prefetch == NULL) return NULL;
 
-					rc   = ODBC_BindParameter(frm, hstmt, params, p, type);
-					if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
-				}
-			}
+	memset(prefetch, 0, sizeof(PREFETCH));
+	prefetch->hstmt   = hstmt;
+	prefetch->columns = columns;
+	prefetch->rowset  = rowset;
 
-			// execute statement
-			//
-			rc = SQLExecute(hstmt);
-			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+	prefetch->sets[0].buffers = ODBC_Alloc(arena, sizeof(void *)   * num_columns);
+	prefetch->sets[0].lengths = ODBC_Alloc(arena, sizeof(SQLLEN *) * num_columns);
+	prefetch->sets[0].status  = rowset->status;
+	prefetch->sets[1].buffers = ODBC_Alloc(arena, sizeof(void *)   * num_columns);
+	prefetch->sets[1].lengths = ODBC_Alloc(arena, sizeof(SQLLEN *) * num_columns);
+	prefetch->sets[1].status  = ODBC_Alloc(arena, sizeof(SQLUSMALLINT) * rowset->size);
+	if (!prefetch->sets[0].buffers || !prefetch->sets[0].lengths
+	||  !prefetch->sets[1].buffers || !prefetch->sets[1].lengths || !prefetch->sets[1].status) return NULL;
 
-			// free param buffers
-			//
-			if (0 < num_params)
-			{
-				type = RL_GET_FIELD(object, RL_MAP_WORD("parameters"), &value); // unproteced
-				if (type == RXT_HANDLE && (params = value.addr))
-				{
-					for (p = 1; p <= num_params; p++) switch (params[p].rebol_type) case RXT_STRING: RXT_BINARY: RXT_DATE: RXT_TIME: free(params[p].buffer);
-					free(params);
-				}
-				RL_SET_FIELD(object, RL_MAP_WORD("parameters"), value, RXT_NONE);
-				//RL_PRINT("ok\n", 0);
-			}
+	for (col = 0; col < num_columns; col++)
+	{
+		prefetch->sets[0].buffers[col] = columns[col].buffer;
+		prefetch->sets[0].lengths[col] = columns[col].lengths;
+		prefetch->sets[1].buffers[col] = ODBC_Alloc(arena, columns[col].buffer_size * rowset->size);
+		prefetch->sets[1].lengths[col] = ODBC_Alloc(arena, sizeof(SQLLEN) * rowset->size);
+		if (!prefetch->sets[1].buffers[col] || !prefetch->sets[1].lengths[col]) return NULL;
+	}
 
-			// free statement
-			//
-			if (statement != previous) free(string);
+	prefetch->wake  = CreateEventW(NULL, FALSE, FALSE, NULL);
+	prefetch->ready = CreateEventW(NULL, FALSE, FALSE, NULL);
+	if (prefetch->wake && prefetch->ready) prefetch->thread = CreateThread(NULL, 0, ODBC_PrefetchThread, prefetch, 0, NULL);
+	if (prefetch->thread == NULL)
+	{
+		if (prefetch->wake)  CloseHandle(prefetch->wake);
+		if (prefetch->ready) CloseHandle(prefetch->ready);
+		return NULL;
+	}
 
-			break;
-		}
+	value.addr = prefetch;
+	RL_SET_FIELD(object, RL_MAP_WORD("prefetcher"), value, RXT_HANDLE);
 
-		// unknown dialect, when first element in the block is something other
-		//
-		default:
-			return MAKE_ERROR(L"Cannot parse dialect!");
-	}
+	return prefetch;
+}
 
-	// Return early with number of rows affected for Insert/Update/Delete statements
-	//
-	rc = SQLNumResultCols(hstmt, &num_columns);
-	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
 
-	if (!num_columns)
+/*******************************************************************************
+**
+*/	SQLRETURN ODBC_FetchAhead(PREFETCH *prefetch)
+/*
+**  Hands out the rowset fetched in the background by swapping the buffers
+**  COLUMNS and ROWSET point to, then has the helper thread fetch the next
+**  one into the buffers just converted. The first rowset is fetched right
+**  away.
+**
+*******************************************************************************/
+{
+	ROWSET_BUFFERS *set;
+	SQLRETURN    rc;
+	int          col;
+
+	if (prefetch->busy)
 	{
-		// statement changes rows (insert/update/delete)
-		//
-		rc = SQLRowCount(hstmt, &num_rows);
-		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+		WaitForSingleObject(prefetch->ready, INFINITE);
+		prefetch->busy = FALSE;
 
-		RXA_INT64(frm, 1) = num_rows;
-		RXA_TYPE (frm, 1) = RXT_INTEGER;
+		rc = prefetch->rc;
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return rc;
+
+		prefetch->front = 1 - prefetch->front;
+		set = &prefetch->sets[prefetch->front];
+
+		for (col = 0; col < prefetch->rowset->num_columns; col++)
+		{
+			prefetch->columns[col].buffer  = set->buffers[col];
+			prefetch->columns[col].lengths = set->lengths[col];
+		}
+		prefetch->rowset->status  = set->status;
+		prefetch->rowset->fetched = set->fetched;
 	}
 	else
 	{
-		// statement returns result-set (select, catalog)
-		//
-		if (statement != previous)
+		if (prefetch->bound != prefetch->front)									// after a failed background fetch
 		{
-			type = RL_GET_FIELD(object, RL_MAP_WORD("columns"), &value); // unproteced
-			if (type == RXT_HANDLE) free(value.addr);
-			type = RL_GET_FIELD(object, RL_MAP_WORD("values"),  &value); // unproteced
-			if (type == RXT_HANDLE) free(value.addr);
+			rc = ODBC_BindRowsetBuffers(prefetch, prefetch->front, &prefetch->rowset->fetched);
+			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return rc;
+		}
 
-			columns = malloc(sizeof(COLUMN) * num_columns);
-			values  = malloc(sizeof(RXIARG) * num_columns);
-			titles  = RL_MAKE_BLOCK(num_columns); //GC'ed by REBOL
+		rc = SQLFetch(prefetch->hstmt);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return rc;
+	}
 
-			if (!columns || !titles || !values) return MAKE_ERROR(L"Couldn't allocate column buffers!");
+	prefetch->busy = TRUE;
+	SetEvent(prefetch->wake);
 
-			value.addr = columns;	RL_SET_FIELD(object, RL_MAP_WORD("columns"), value, RXT_HANDLE);
-			value.addr = values;	RL_SET_FIELD(object, RL_MAP_WORD("values"),  value, RXT_HANDLE);
+	return rc;
+}
 
-			rc = ODBC_DescribeResults(frm, hstmt, num_columns, columns, titles);
-			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
 
-			value.addr = titles; RL_SET_FIELD(object, RL_MAP_WORD("titles"), value, RXT_HANDLE); // remember column titles
+/*******************************************************************************
+**
+*/	DWORD WINAPI ODBC_PrefetchThread(void *data)
+/*
+*******************************************************************************/
+{
+	PREFETCH    *prefetch = data;
+	LONGLONG     ticks;
+	int          back;
 
-			rc = ODBC_BindColumns(frm, hstmt, num_columns, columns, values);
-			if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
-		}
-		else
+	for (;;)
+	{
+		WaitForSingleObject(prefetch->wake, INFINITE);
+		if (prefetch->quit) return 0;
+
+		back = 1 - prefetch->front;
+
+		prefetch->rc = ODBC_BindRowsetBuffers(prefetch, back, &prefetch->sets[back].fetched);
+		if (prefetch->rc == SQL_SUCCESS || prefetch->rc == SQL_SUCCESS_WITH_INFO)
 		{
-			titles = (REBSER*)(RL_GET_FIELD(object, RL_MAP_WORD("titles"), &value) == RXT_HANDLE) ? value.addr : hnull; // retrieve column titles from previous preparation
-			if (!titles) return MAKE_ERROR(L"Couldn't retrieve previous column titles!");
+			ticks        = ODBC_TRACE_TICKS();
+			prefetch->rc = SQLFetch(prefetch->hstmt);
+			ODBC_TRACE("SQLFetch", prefetch->hstmt, ticks, (i64)prefetch->sets[back].fetched, prefetch->rc);
 		}
 
-		// Store column titles
-		//
-		RXA_SERIES(frm, 1) = titles;
-		RXA_INDEX (frm, 1) = 0;
-		RXA_TYPE  (frm, 1) = RXT_BLOCK;
+		SetEvent(prefetch->ready);
 	}
-
-	return RXR_VALUE;
 }
 
 
 /*******************************************************************************
 **
-*/	RXIEXT int ODBC_Copy(RXIFRM *frm)
+*/	SQLRETURN ODBC_BindRowsetBuffers(PREFETCH *prefetch, int set, SQLULEN *fetched)
 /*
-**  Returns the result set for SQL-Select statements and catalog functions as
-**  as a (result-set) block of (row) blocks.
+**  Binds the columns, row status and rows fetched count to one of the two
+**  rowset buffers.
 **
 *******************************************************************************/
 {
-	COLUMN      *columns, *column;
-	RXIARG      *values, value;
-	REBSER      *object, *records, *record;
-	SQLHSTMT     hstmt;
-	SQLSMALLINT  col, num_columns;
-	SQLULEN      row;
+	COLUMN      *column;
 	SQLRETURN    rc;
-	int          rebol_type;
-	i32			 num_rows, i;
+	int          col;
 
-	object   = RXA_OBJECT(frm, 1); // statement object
-	num_rows = RXA_INT32( frm, 2);
+	prefetch->bound = set;
 
-	hstmt   = (SQLHSTMT*)(RL_GET_FIELD(object, RL_MAP_WORD("statement"), &value) == RXT_HANDLE) ? value.addr : NULL;
-	columns = (COLUMN  *)(RL_GET_FIELD(object, RL_MAP_WORD("columns"),   &value) == RXT_HANDLE) ? value.addr : NULL;
-	values  = (RXIARG  *)(RL_GET_FIELD(object, RL_MAP_WORD("values"),    &value) == RXT_HANDLE) ? value.addr : NULL;
+	rc = SQLSetStmtAttr(prefetch->hstmt, SQL_ATTR_ROW_STATUS_PTR, prefetch->sets[set].status, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return rc;
 
-	if (!hstmt || !columns || !values) return MAKE_ERROR(L"Invalid statement object!");
+	rc = SQLSetStmtAttr(prefetch->hstmt, SQL_ATTR_ROWS_FETCHED_PTR, fetched, 0);
+	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return rc;
 
-	records = RL_MAKE_BLOCK(128); //GC'ed by REBOL
-	if (records == NULL) return MAKE_ERROR(L"Couldn't allocate rows buffer!");
+	for (col = 0; col < prefetch->rowset->num_columns; col++)
+	{
+		column = &prefetch->columns[col];
 
-	rc = SQLNumResultCols(hstmt, &num_columns);
-	if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return ODBC_ReturnError(frm, SQL_HANDLE_STMT, hstmt);
+		rc = SQLBindCol(prefetch->hstmt, (SQLSMALLINT)(col + 1),
+						  column->c_type,
+						  prefetch->sets[set].buffers[col],
+						  column->buffer_size,
+						  prefetch->sets[set].lengths[col]
+		);
+		if (rc != SQL_SUCCESS && rc != SQL_SUCCESS_WITH_INFO) return rc;
+	}
 
-	if (num_rows == 0) num_rows = -1;
-	row = 0;
+	return SQL_SUCCESS;
+}
 
-	while ((row != num_rows) && (SQLFetch(hstmt) != SQL_NO_DATA))  // Fetch columns
-	{
-		record = RL_MAKE_BLOCK(num_columns);
-		if (record == NULL) return MAKE_ERROR(L"Couldn't allocate record block!");
 
-		for (col = 0; col <= num_columns - 1; col++)
-		{
-			column     = &columns[col];
-			rebol_type = ODBC_ConvertSqlToRebol(column);
+/*******************************************************************************
+**
+*/	SQLULEN ODBC_StopPrefetch(REBSER *statement)
+/*
+**  Ends the helper thread of a prefetching statement and points the columns
+**  and their bindings back at the plan's own rowset buffers.
+**
+**  Returns the number of rows the driver's cursor is ahead of the rowset
+**  rows are handed out from, i.e. the rows of that rowset if the next one
+**  was fetched in the background, else 0.
+**
+*******************************************************************************/
+{
+	RXIARG       value;
+	PREFETCH    *prefetch;
+	SQLULEN      ahead = 0;
+	int          col;
 
-			RL_SET_VALUE(record, col, column->value, rebol_type);
-		}
+	if (RL_GET_FIELD(statement, RL_MAP_WORD("prefetcher"), &value) != RXT_HANDLE) return 0;
 
-		value.series = record;
-		value.index  = 0;
-		RL_SET_VALUE(records, row++, value, RXT_BLOCK);
+	prefetch = value.addr;
+
+	if (prefetch->busy)
+	{
+		WaitForSingleObject(prefetch->ready, INFINITE);
+		ahead = prefetch->rowset->fetched;
 	}
 
-	RXA_SERIES(frm, 1) = records;
-	RXA_INDEX (frm, 1) = 0;
-	RXA_TYPE  (frm, 1) = RXT_BLOCK;
-	return RXR_VALUE;
-}
+	prefetch->quit = TRUE;
+	SetEvent(prefetch->wake);
+	WaitForSingleObject(prefetch->thread, INFINITE);
 
+	CloseHandle(prefetch->thread);
+	CloseHandle(prefetch->wake);
+	CloseHandle(prefetch->ready);
 
+	for (col = 0; col < prefetch->rowset->num_columns; col++)
+	{
+		prefetch->columns[col].buffer  = prefetch->sets[0].buffers[col];
+		prefetch->columns[col].lengths = prefetch->sets[0].lengths[col];
+	}
+	prefetch->rowset->status = prefetch->sets[0].status;
 
+	ODBC_BindRowsetBuffers(prefetch, 0, &prefetch->rowset->fetched);
 
+	RL_SET_FIELD(statement, RL_MAP_WORD("prefetcher"), value, RXT_NONE);		// the rest goes with the arena
+
+	return ahead;
+}